@@ -0,0 +1,196 @@
+// Measures pose evaluation for one character: a 200-bone skeleton playing a
+// 10 second clip keyed 30 times a second, frame by frame at 60 fps. Keyframe
+// lookup is compared with and without per-playback cursors, on evenly spaced
+// keys (division fast path) and on jittered keys (cursor or binary search),
+// plus random seeks where cursors can't help, and a crossfade between the two
+// clips (two local poses sampled, blended and composed once), and a layered
+// graph: blend space base, masked override and additive layer (four
+// samplings, one hierarchy pass). Last, the evenly spaced clip compressed:
+// key memory and sampling cost of the decoding path. Keys are random, so
+// compression here is quantization only; key reduction depends on the data.
+
+#include "bench.hpp"
+
+#include <engine/pbr/animation.hpp>
+#include <engine/pbr/animation_compression.hpp>
+#include <engine/pbr/animation_graph.hpp>
+
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <cstdio>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace engine::pbr;
+
+namespace {
+
+constexpr int BONE_COUNT = 200;
+constexpr float CLIP_SECONDS = 10.0f;
+constexpr float TICKS_PER_SECOND = 30.0f;  // One key per tick
+constexpr float FRAME_SECONDS = 1.0f / 60.0f;
+constexpr int FRAMES = 600;
+constexpr int ITERATIONS = 5;
+
+// Random tree: every bone hangs off an earlier one
+Skeleton make_skeleton(std::mt19937& rng) {
+    std::vector<SkeletonNode> nodes(BONE_COUNT);
+    std::vector<int> parents(BONE_COUNT, -1);
+    auto bone_index_map = std::make_shared<std::unordered_map<std::string, int>>();
+
+    for (int i = 0; i < BONE_COUNT; ++i) {
+        nodes[i].name = "bone" + std::to_string(i);
+        nodes[i].transformation = glm::translate(glm::mat4(1.0f), glm::vec3(0.0f, 0.1f, 0.0f));
+        parents[i] = i > 0 ? static_cast<int>(rng() % i) : -1;
+        (*bone_index_map)[nodes[i].name] = i;
+    }
+    for (int i = BONE_COUNT - 1; i > 0; --i) {
+        auto& siblings = nodes[parents[i]].children;
+        siblings.insert(siblings.begin(), std::move(nodes[i]));
+    }
+
+    Skeleton skeleton(BONE_COUNT);
+    skeleton.bone_index_map = bone_index_map;
+    skeleton.root_node = std::make_shared<SkeletonNode>(std::move(nodes[0]));
+    skeleton.build_hierarchy();
+    return skeleton;
+}
+
+AnimationClip make_clip(std::mt19937& rng, bool jittered) {
+    std::uniform_real_distribution<float> value_dist(-1.0f, 1.0f);
+    std::uniform_real_distribution<float> jitter_dist(-0.3f, 0.3f);
+
+    const int key_count = static_cast<int>(CLIP_SECONDS * TICKS_PER_SECOND) + 1;
+
+    AnimationClip clip;
+    clip.set_duration(CLIP_SECONDS * TICKS_PER_SECOND);
+    clip.set_ticks_per_second(TICKS_PER_SECOND);
+
+    for (int bone = 0; bone < BONE_COUNT; ++bone) {
+        AnimationChannel channel;
+        channel.bone_name = "bone" + std::to_string(bone);
+        for (int key = 0; key < key_count; ++key) {
+            float time = static_cast<float>(key);
+            if (jittered && key > 0 && key + 1 < key_count) time += jitter_dist(rng);
+
+            glm::quat rotation = glm::normalize(glm::quat(1.0f, value_dist(rng) * 0.2f,
+                                                          value_dist(rng) * 0.2f, value_dist(rng) * 0.2f));
+            channel.position_keys.push_back({time, glm::vec3(value_dist(rng), value_dist(rng), value_dist(rng))});
+            channel.rotation_keys.push_back({time, rotation});
+            channel.scale_keys.push_back({time, glm::vec3(1.0f)});
+        }
+        clip.add_channel(std::move(channel));
+    }
+    return clip;
+}
+
+void run(const char* name, const AnimationClip& clip, Skeleton& skeleton, bool use_cursors, bool seek) {
+    std::mt19937 rng(7);
+    std::uniform_real_distribution<float> time_dist(0.0f, clip.duration());
+
+    std::vector<float> times(FRAMES);
+    for (int frame = 0; frame < FRAMES; ++frame) {
+        times[frame] = seek ? time_dist(rng) : frame * FRAME_SECONDS * TICKS_PER_SECOND;
+    }
+
+    std::vector<ChannelCursor> cursors;
+    double ms = bench::measure_ms(ITERATIONS, [&]() {
+        for (float time : times) {
+            clip.apply(skeleton, time, use_cursors ? &cursors : nullptr);
+        }
+        bench::do_not_optimize(skeleton.transforms[BONE_COUNT - 1]);
+    });
+
+    std::printf("%-22s %-10s %-7s %8.2f us/pose\n", name, use_cursors ? "cursors" : "no cursor",
+                seek ? "seek" : "play", ms * 1e3 / FRAMES);
+}
+
+void run_crossfade(const std::shared_ptr<AnimationClip>& from, const std::shared_ptr<AnimationClip>& to,
+                   Skeleton& skeleton) {
+    double ms = bench::measure_ms(ITERATIONS, [&]() {
+        AnimationState state;
+        state.set_clip(from);
+        state.play();
+        state.crossfade_to(to, FRAMES * FRAME_SECONDS * 2.0f);  // Blending for the whole run
+        for (int frame = 0; frame < FRAMES; ++frame) {
+            state.update(FRAME_SECONDS);
+            state.apply(skeleton);
+        }
+        bench::do_not_optimize(skeleton.transforms[BONE_COUNT - 1]);
+    });
+
+    std::printf("%-22s %-10s %-7s %8.2f us/pose\n", "crossfade", "cursors", "play", ms * 1e3 / FRAMES);
+}
+
+void run_layers(const std::shared_ptr<AnimationClip>& first, const std::shared_ptr<AnimationClip>& second,
+                Skeleton& skeleton) {
+    auto locomotion = std::make_shared<BlendSpace1D>();
+    locomotion->add_clip(first, 0.0f);
+    locomotion->add_clip(second, 1.0f);
+    locomotion->set_parameter(0.5f);
+
+    AnimationGraph graph;
+    graph.add_layer().set_blend_space(locomotion);
+
+    AnimationLayer& upper = graph.add_layer();
+    upper.play(second);
+    upper.set_mask(std::make_shared<BoneMask>(BoneMask::subtree(*skeleton.hierarchy, "bone1")));
+
+    AnimationLayer& additive = graph.add_layer();
+    additive.play(first);
+    additive.set_mode(LayerBlendMode::Additive);
+    additive.set_additive_reference(first);
+    additive.set_weight(0.5f);
+
+    double ms = bench::measure_ms(ITERATIONS, [&]() {
+        for (int frame = 0; frame < FRAMES; ++frame) {
+            graph.update(FRAME_SECONDS);
+            graph.apply(skeleton);
+        }
+        bench::do_not_optimize(skeleton.transforms[BONE_COUNT - 1]);
+    });
+
+    std::printf("%-22s %-10s %-7s %8.2f us/pose\n", "3 layers, 4 clips", "cursors", "play", ms * 1e3 / FRAMES);
+}
+
+size_t key_bytes(const AnimationClip& clip) {
+    if (clip.is_compressed()) return clip.compressed()->memory_usage();
+
+    size_t bytes = 0;
+    for (const AnimationChannel& channel : clip.channels()) {
+        bytes += channel.position_keys.size() * sizeof(PositionKey) +
+                 channel.rotation_keys.size() * sizeof(RotationKey) +
+                 channel.scale_keys.size() * sizeof(ScaleKey);
+    }
+    return bytes;
+}
+
+}  // namespace
+
+int main() {
+    std::mt19937 rng(42);
+    Skeleton skeleton = make_skeleton(rng);
+    auto uniform_clip = std::make_shared<AnimationClip>(make_clip(rng, false));
+    auto jittered_clip = std::make_shared<AnimationClip>(make_clip(rng, true));
+
+    std::printf("%d bones, %.0f s clip, %.0f keys per second\n", BONE_COUNT, CLIP_SECONDS, TICKS_PER_SECOND);
+    for (bool seek : {false, true}) {
+        run("evenly spaced keys", *uniform_clip, skeleton, false, seek);
+        run("evenly spaced keys", *uniform_clip, skeleton, true, seek);
+        run("jittered keys", *jittered_clip, skeleton, false, seek);
+        run("jittered keys", *jittered_clip, skeleton, true, seek);
+    }
+    run_crossfade(uniform_clip, jittered_clip, skeleton);
+    run_layers(uniform_clip, jittered_clip, skeleton);
+
+    AnimationClip compressed_clip = *uniform_clip;
+    compressed_clip.compress();
+    std::printf("key memory: %zu KB loaded, %zu KB compressed\n", key_bytes(*uniform_clip) / 1024,
+                key_bytes(compressed_clip) / 1024);
+    for (bool seek : {false, true}) {
+        run("compressed keys", compressed_clip, skeleton, true, seek);
+    }
+    return 0;
+}
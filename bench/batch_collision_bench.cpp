@@ -0,0 +1,189 @@
+// Measures the one-vs-many overlap kernels against the scalar pair tests they
+// replace: a batch of query shapes, each tested against every shape of a
+// structure-of-arrays batch (projectiles against all enemies). Positions are
+// spread so a few percent to a tenth of the pairs overlap; both forms must agree on
+// the hit count.
+
+#include "bench.hpp"
+
+#include <engine/physics/batch_collision.hpp>
+#include <engine/physics/collision.hpp>
+#include <engine/physics/simd.hpp>
+
+#include <cstdio>
+#include <random>
+#include <vector>
+
+using namespace engine::physics;
+
+namespace {
+
+constexpr int QUERY_COUNT = 64;
+constexpr float WORLD_SIZE = 8.0f;
+
+struct Scene {
+    std::vector<glm::vec3> query_positions;
+    std::vector<float> query_sizes;
+    std::vector<glm::vec3> target_positions;
+    std::vector<float> target_sizes;
+};
+
+Scene make_scene(int target_count) {
+    std::mt19937 rng(42);
+    std::uniform_real_distribution<float> pos_dist(0.0f, WORLD_SIZE);
+    std::uniform_real_distribution<float> size_dist(0.3f, 0.8f);
+
+    Scene scene;
+    for (int i = 0; i < QUERY_COUNT; ++i) {
+        scene.query_positions.push_back(glm::vec3(pos_dist(rng), pos_dist(rng), pos_dist(rng)));
+        scene.query_sizes.push_back(size_dist(rng) * 2.0f);
+    }
+    for (int i = 0; i < target_count; ++i) {
+        scene.target_positions.push_back(glm::vec3(pos_dist(rng), pos_dist(rng), pos_dist(rng)));
+        scene.target_sizes.push_back(size_dist(rng) * 2.0f);
+    }
+    return scene;
+}
+
+void report(const char* name, int target_count, double ms, size_t hits) {
+    double pairs = static_cast<double>(QUERY_COUNT) * target_count;
+    std::printf("%-24s %6d targets %8.3f ms  %8.1f Mpairs/s  (%zu hit)\n",
+                name, target_count, ms, pairs / (ms * 1e3), hits);
+}
+
+int iterations_for(int target_count) {
+    return target_count >= 16384 ? 20 : 200;
+}
+
+void run_spheres(int target_count) {
+    Scene scene = make_scene(target_count);
+    const int iterations = iterations_for(target_count);
+
+    SphereBatch batch;
+    std::vector<SphereShape> shapes;
+    for (int i = 0; i < target_count; ++i) {
+        batch.push_back(scene.target_positions[i], scene.target_sizes[i]);
+        shapes.push_back(SphereShape(scene.target_sizes[i]));
+    }
+
+    size_t scalar_hits = 0;
+    double scalar_ms = bench::measure_ms(iterations, [&]() {
+        scalar_hits = 0;
+        for (int q = 0; q < QUERY_COUNT; ++q) {
+            SphereShape query(scene.query_sizes[q]);
+            for (int i = 0; i < target_count; ++i) {
+                auto result = test_sphere_sphere(query, scene.query_positions[q], shapes[i],
+                                                 scene.target_positions[i]);
+                scalar_hits += result.collided ? 1 : 0;
+            }
+        }
+        bench::do_not_optimize(scalar_hits);
+    });
+
+    std::vector<uint32_t> hits;
+    size_t batch_hits = 0;
+    double batch_ms = bench::measure_ms(iterations, [&]() {
+        batch_hits = 0;
+        for (int q = 0; q < QUERY_COUNT; ++q) {
+            batch_hits += overlap_sphere_spheres(scene.query_positions[q], scene.query_sizes[q], batch, hits);
+        }
+        bench::do_not_optimize(batch_hits);
+    });
+
+    report("sphere/sphere scalar", target_count, scalar_ms, scalar_hits);
+    report("sphere/sphere batch", target_count, batch_ms, batch_hits);
+}
+
+void run_capsules(int target_count) {
+    Scene scene = make_scene(target_count);
+    const int iterations = iterations_for(target_count);
+
+    SphereBatch batch;
+    std::vector<SphereShape> shapes;
+    for (int i = 0; i < target_count; ++i) {
+        batch.push_back(scene.target_positions[i], scene.target_sizes[i]);
+        shapes.push_back(SphereShape(scene.target_sizes[i]));
+    }
+
+    size_t scalar_hits = 0;
+    double scalar_ms = bench::measure_ms(iterations, [&]() {
+        scalar_hits = 0;
+        for (int q = 0; q < QUERY_COUNT; ++q) {
+            CapsuleShape query(scene.query_sizes[q] * 0.5f, 2.0f);
+            for (int i = 0; i < target_count; ++i) {
+                auto result = test_capsule_sphere(query, scene.query_positions[q], shapes[i],
+                                                  scene.target_positions[i]);
+                scalar_hits += result.collided ? 1 : 0;
+            }
+        }
+        bench::do_not_optimize(scalar_hits);
+    });
+
+    std::vector<uint32_t> hits;
+    size_t batch_hits = 0;
+    double batch_ms = bench::measure_ms(iterations, [&]() {
+        batch_hits = 0;
+        for (int q = 0; q < QUERY_COUNT; ++q) {
+            CapsuleShape query(scene.query_sizes[q] * 0.5f, 2.0f);
+            batch_hits += overlap_capsule_spheres(query, scene.query_positions[q], batch, hits);
+        }
+        bench::do_not_optimize(batch_hits);
+    });
+
+    report("capsule/sphere scalar", target_count, scalar_ms, scalar_hits);
+    report("capsule/sphere batch", target_count, batch_ms, batch_hits);
+}
+
+void run_boxes(int target_count) {
+    Scene scene = make_scene(target_count);
+    const int iterations = iterations_for(target_count);
+
+    AABBBatch batch;
+    std::vector<AABB> boxes;
+    for (int i = 0; i < target_count; ++i) {
+        glm::vec3 half(scene.target_sizes[i]);
+        boxes.push_back(AABB(scene.target_positions[i] - half, scene.target_positions[i] + half));
+        batch.push_back(boxes.back());
+    }
+
+    size_t scalar_hits = 0;
+    double scalar_ms = bench::measure_ms(iterations, [&]() {
+        scalar_hits = 0;
+        for (int q = 0; q < QUERY_COUNT; ++q) {
+            glm::vec3 half(scene.query_sizes[q]);
+            AABB query(scene.query_positions[q] - half, scene.query_positions[q] + half);
+            for (int i = 0; i < target_count; ++i) {
+                scalar_hits += query.overlaps(boxes[i]) ? 1 : 0;
+            }
+        }
+        bench::do_not_optimize(scalar_hits);
+    });
+
+    std::vector<uint32_t> hits;
+    size_t batch_hits = 0;
+    double batch_ms = bench::measure_ms(iterations, [&]() {
+        batch_hits = 0;
+        for (int q = 0; q < QUERY_COUNT; ++q) {
+            glm::vec3 half(scene.query_sizes[q]);
+            AABB query(scene.query_positions[q] - half, scene.query_positions[q] + half);
+            batch_hits += overlap_aabb_aabbs(query, batch, hits);
+        }
+        bench::do_not_optimize(batch_hits);
+    });
+
+    report("aabb/aabb scalar", target_count, scalar_ms, scalar_hits);
+    report("aabb/aabb batch", target_count, batch_ms, batch_hits);
+}
+
+}  // namespace
+
+int main() {
+    std::printf("simd width: %d lanes, %d queries per batch\n", simd::WIDTH, QUERY_COUNT);
+
+    for (int target_count : {64, 1024, 16384}) {
+        run_spheres(target_count);
+        run_capsules(target_count);
+        run_boxes(target_count);
+    }
+    return 0;
+}
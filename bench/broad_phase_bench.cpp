@@ -0,0 +1,82 @@
+// Compares PhysicsWorld::update cost for each broad phase on a crowd of
+// enemy-sized spheres that all walk toward the origin (coherent motion).
+
+#include "bench.hpp"
+
+#include <engine/physics/physics_world.hpp>
+
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+using namespace engine::physics;
+
+namespace {
+
+constexpr float STEP = 1.0f / 60.0f;
+constexpr float MOVE_SPEED = 3.5f;  // Melee enemy move speed
+constexpr int STEPS = 30;
+
+const char* broad_phase_name(BroadPhaseType type) {
+    switch (type) {
+        case BroadPhaseType::BruteForce:    return "brute_force";
+        case BroadPhaseType::SpatialHash:   return "spatial_hash";
+        case BroadPhaseType::SweepAndPrune: return "sweep_and_prune";
+    }
+    return "unknown";
+}
+
+void run(BroadPhaseType type, int body_count) {
+    // Constant density: roughly one body per 4 square units
+    float spawn_radius = std::sqrt(static_cast<float>(body_count) * 4.0f / 3.14159f);
+
+    std::mt19937 rng(1234);
+    std::uniform_real_distribution<float> angle_dist(0.0f, 6.28318f);
+    std::uniform_real_distribution<float> radius_dist(0.0f, 1.0f);
+
+    std::vector<RigidBody> bodies(body_count);
+    PhysicsWorld world;
+    world.set_gravity(glm::vec3(0.0f));
+    world.set_broad_phase(type);
+
+    for (RigidBody& body : bodies) {
+        float angle = angle_dist(rng);
+        float radius = spawn_radius * std::sqrt(radius_dist(rng));
+        body.set_position(glm::vec3(std::cos(angle) * radius, 0.5f, std::sin(angle) * radius));
+        body.set_use_gravity(false);
+        body.set_drag(0.0f);
+        body.set_sphere(0.5f);
+        world.add_body(&body);
+    }
+
+    double ms = bench::measure_ms(STEPS, [&]() {
+        for (RigidBody& body : bodies) {
+            glm::vec3 to_player = -body.position();
+            to_player.y = 0.0f;
+            float dist = glm::length(to_player);
+            body.set_velocity(dist > 0.001f ? to_player / dist * MOVE_SPEED : glm::vec3(0.0f));
+        }
+        world.update(STEP);
+    });
+
+    std::printf("%-16s %6d bodies  %10.3f ms/step\n", broad_phase_name(type), body_count, ms);
+}
+
+}  // namespace
+
+int main() {
+    const int counts[] = {100, 1000, 10000};
+    const BroadPhaseType types[] = {
+        BroadPhaseType::BruteForce,
+        BroadPhaseType::SpatialHash,
+        BroadPhaseType::SweepAndPrune,
+    };
+
+    for (int count : counts) {
+        for (BroadPhaseType type : types) {
+            run(type, count);
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,106 @@
+// Cost of moving a crowd of kinematic character controllers (enemies
+// chasing a player that runs in a circle) with one batched call per step,
+// on a height field ground with the other characters in the way.
+
+#include "bench.hpp"
+
+#include <engine/physics/character_controller.hpp>
+#include <engine/physics/height_field.hpp>
+#include <engine/physics/physics_world.hpp>
+
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+using namespace engine::physics;
+
+namespace {
+
+constexpr float STEP = 1.0f / 60.0f;
+constexpr int WARMUP_STEPS = 120;
+constexpr int MEASURED_STEPS = 300;
+constexpr float ENEMY_SPEED = 3.5f;
+constexpr float TARGET_RADIUS = 6.0f;   // Circle the target runs on
+constexpr float TARGET_SPEED = 0.5f;    // Radians per second
+
+void run(int count) {
+    // Rolling 100x100 ground
+    constexpr uint32_t SAMPLES = 101;
+    std::vector<float> heights(SAMPLES * SAMPLES);
+    for (uint32_t row = 0; row < SAMPLES; ++row) {
+        for (uint32_t column = 0; column < SAMPLES; ++column) {
+            heights[row * SAMPLES + column] = 0.3f * std::sin(column * 0.3f) * std::cos(row * 0.25f);
+        }
+    }
+    HeightField field(SAMPLES, SAMPLES, 1.0f, std::move(heights));
+
+    PhysicsWorld world;
+    RigidBody ground;
+    ground.set_shape(HeightFieldShape(&field, glm::vec3(-50.0f, 0.0f, -50.0f)));
+    ground.set_static(true);
+    world.add_body(&ground);
+
+    // Spawn on a ring around the target, like a wave
+    std::mt19937 rng(42);
+    std::uniform_real_distribution<float> angle_dist(0.0f, 6.28318f);
+    std::uniform_real_distribution<float> radius_dist(15.0f, 35.0f);
+
+    CharacterSettings settings;
+    settings.radius = 0.5f;
+    settings.height = 1.0f;
+
+    std::vector<CharacterController> enemies(count);
+    std::vector<CharacterController*> controllers;
+    for (CharacterController& enemy : enemies) {
+        float angle = angle_dist(rng);
+        float radius = radius_dist(rng);
+        enemy.set_settings(settings);
+        enemy.set_position(glm::vec3(std::cos(angle) * radius, 1.0f, std::sin(angle) * radius));
+        enemy.add_to_world(world);
+        controllers.push_back(&enemy);
+    }
+
+    float time = 0.0f;
+    auto step = [&]() {
+        time += STEP;
+        glm::vec3 target(std::cos(time * TARGET_SPEED) * TARGET_RADIUS, 0.0f,
+                         std::sin(time * TARGET_SPEED) * TARGET_RADIUS);
+        for (CharacterController& enemy : enemies) {
+            glm::vec3 to_target = target - enemy.position();
+            to_target.y = 0.0f;
+            float distance = glm::length(to_target);
+            enemy.set_desired_velocity(distance > 1e-3f ? to_target * (ENEMY_SPEED / distance) : glm::vec3(0.0f));
+        }
+        CharacterController::move_all(world, controllers.data(), controllers.size(), STEP);
+    };
+
+    for (int i = 0; i < WARMUP_STEPS; ++i) {
+        step();
+        world.update(STEP);
+    }
+
+    double move_ms = 0.0;
+    for (int i = 0; i < MEASURED_STEPS; ++i) {
+        move_ms += bench::measure_ms(1, step);
+        world.update(STEP);
+    }
+    move_ms /= MEASURED_STEPS;
+
+    size_t grounded = 0;
+    for (const CharacterController& enemy : enemies) {
+        grounded += enemy.is_grounded() ? 1 : 0;
+    }
+
+    std::printf("%5d characters  %8.3f ms/step  %7.0f ns/character  (%zu grounded)\n",
+                count, move_ms, move_ms * 1e6 / count, grounded);
+}
+
+}  // namespace
+
+int main() {
+    for (int count : {100, 300, 1000}) {
+        run(count);
+    }
+    return 0;
+}
@@ -0,0 +1,107 @@
+// Dumps PhysicsWorld's profiler stats as CSV, one row per step, for tuning
+// the broad phase against a game-like scene: a crowd of enemy-sized spheres
+// walking toward the origin on a ground box, plus a rain of crates that pile
+// up and fall asleep. Each spatial hash cell size and sweep-and-prune run the
+// same scene, so rows can be compared step by step.
+//
+//   ./bench/physics_profile_bench > physics_profile.csv
+
+#include <engine/physics/physics_world.hpp>
+#include <engine/physics/spatial_hash_broad_phase.hpp>
+
+#include <cmath>
+#include <cstdio>
+#include <memory>
+#include <random>
+#include <vector>
+
+using namespace engine::physics;
+
+namespace {
+
+constexpr float STEP = 1.0f / 60.0f;
+constexpr float MOVE_SPEED = 3.5f;  // Melee enemy move speed
+constexpr int STEPS = 300;
+constexpr int CROWD_COUNT = 1000;
+constexpr int CRATE_COUNT = 300;
+
+struct Config {
+    BroadPhaseType type;
+    float cell_size;  // Spatial hash only
+};
+
+void run(const Config& config) {
+    std::mt19937 rng(1234);
+    std::uniform_real_distribution<float> unit_dist(0.0f, 1.0f);
+
+    PhysicsWorld world;
+    if (config.type == BroadPhaseType::SpatialHash) {
+        world.set_broad_phase(std::make_unique<SpatialHashBroadPhase>(config.cell_size));
+    } else {
+        world.set_broad_phase(config.type);
+    }
+    world.set_profiling_enabled(true);
+
+    RigidBody ground;
+    ground.set_static(true);
+    ground.set_aabb(glm::vec3(100.0f, 0.5f, 100.0f));
+    ground.set_position(glm::vec3(0.0f, -0.5f, 0.0f));
+    world.add_body(&ground);
+
+    // Crowd: constant density of roughly one body per 4 square units
+    float spawn_radius = std::sqrt(CROWD_COUNT * 4.0f / 3.14159f);
+    std::vector<RigidBody> crowd(CROWD_COUNT);
+    for (RigidBody& body : crowd) {
+        float angle = unit_dist(rng) * 6.28318f;
+        float radius = spawn_radius * std::sqrt(unit_dist(rng));
+        body.set_position(glm::vec3(std::cos(angle) * radius, 0.5f, std::sin(angle) * radius));
+        body.set_drag(0.0f);
+        body.set_sphere(0.5f);
+        world.add_body(&body);
+    }
+
+    // Crates dropped over an area off to the side
+    std::vector<RigidBody> crates(CRATE_COUNT);
+    for (RigidBody& crate : crates) {
+        crate.set_position(glm::vec3(50.0f + unit_dist(rng) * 30.0f, 1.0f + unit_dist(rng) * 5.0f,
+                                     unit_dist(rng) * 30.0f));
+        crate.set_aabb(glm::vec3(0.4f));
+        world.add_body(&crate);
+    }
+
+    for (int step = 0; step < STEPS; ++step) {
+        for (RigidBody& body : crowd) {
+            glm::vec3 to_player = -body.position();
+            to_player.y = 0.0f;
+            float dist = glm::length(to_player);
+            glm::vec3 velocity = dist > 0.001f ? to_player / dist * MOVE_SPEED : glm::vec3(0.0f);
+            velocity.y = body.velocity().y;
+            body.set_velocity(velocity);
+        }
+        world.update(STEP);
+
+        const char* name = config.type == BroadPhaseType::SpatialHash ? "spatial_hash" : "sweep_and_prune";
+        std::printf("%s,%.2f,%d,", name, config.cell_size, step);
+        write_stats_csv_row(stdout, world.stats());
+    }
+}
+
+}  // namespace
+
+int main() {
+    const Config configs[] = {
+        {BroadPhaseType::SpatialHash, 0.5f},
+        {BroadPhaseType::SpatialHash, 1.0f},
+        {BroadPhaseType::SpatialHash, 2.0f},
+        {BroadPhaseType::SpatialHash, 4.0f},
+        {BroadPhaseType::SpatialHash, 8.0f},
+        {BroadPhaseType::SweepAndPrune, 0.0f},
+    };
+
+    std::printf("broad_phase,cell_size,step,");
+    write_stats_csv_header(stdout);
+    for (const Config& config : configs) {
+        run(config);
+    }
+    return 0;
+}
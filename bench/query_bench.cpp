@@ -0,0 +1,116 @@
+// Compares the allocating and allocation-free forms of PhysicsWorld's sphere
+// query (area damage radius around points in an enemy crowd). Heap
+// allocations are counted by replacing the global operator new.
+
+#include "bench.hpp"
+
+#include <engine/physics/physics_world.hpp>
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <random>
+#include <vector>
+
+using namespace engine::physics;
+
+namespace {
+
+size_t g_allocations = 0;
+
+}  // namespace
+
+void* operator new(std::size_t size) {
+    ++g_allocations;
+    if (void* ptr = std::malloc(size ? size : 1)) return ptr;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* ptr) noexcept {
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept {
+    std::free(ptr);
+}
+
+namespace {
+
+constexpr int BODY_COUNT = 2000;
+constexpr int QUERY_COUNT = 1000;
+constexpr int ITERATIONS = 50;
+constexpr float QUERY_RADIUS = 3.0f;
+
+template <typename Fn>
+void run(const char* name, Fn&& query) {
+    size_t found = 0;
+    size_t allocations_before = g_allocations;
+
+    double ms = bench::measure_ms(ITERATIONS, [&]() {
+        found = 0;
+        for (int i = 0; i < QUERY_COUNT; ++i) {
+            found += query(i);
+        }
+    });
+
+    double allocations = static_cast<double>(g_allocations - allocations_before) /
+                         (static_cast<double>(ITERATIONS) * QUERY_COUNT);
+    std::printf("%-14s %8.1f ns/query  %6.2f allocs/query  (%zu bodies found)\n",
+                name, ms * 1e6 / QUERY_COUNT, allocations, found);
+}
+
+}  // namespace
+
+int main() {
+    // Constant density: roughly one body per 4 square units
+    float spawn_radius = std::sqrt(static_cast<float>(BODY_COUNT) * 4.0f / 3.14159f);
+
+    std::mt19937 rng(1234);
+    std::uniform_real_distribution<float> angle_dist(0.0f, 6.28318f);
+    std::uniform_real_distribution<float> radius_dist(0.0f, 1.0f);
+
+    std::vector<RigidBody> bodies(BODY_COUNT);
+    PhysicsWorld world;
+    world.set_gravity(glm::vec3(0.0f));
+
+    for (RigidBody& body : bodies) {
+        float angle = angle_dist(rng);
+        float radius = spawn_radius * std::sqrt(radius_dist(rng));
+        body.set_position(glm::vec3(std::cos(angle) * radius, 0.5f, std::sin(angle) * radius));
+        body.set_use_gravity(false);
+        body.set_sphere(0.5f);
+        world.add_body(&body);
+    }
+    world.update(0.0f);  // Build the query tree
+
+    std::vector<glm::vec3> centers(QUERY_COUNT);
+    for (glm::vec3& center : centers) {
+        float angle = angle_dist(rng);
+        float radius = spawn_radius * std::sqrt(radius_dist(rng));
+        center = glm::vec3(std::cos(angle) * radius, 0.5f, std::sin(angle) * radius);
+    }
+
+    std::printf("%d bodies, %d sphere queries of radius %.1f\n", BODY_COUNT, QUERY_COUNT, QUERY_RADIUS);
+
+    run("by value", [&](int i) {
+        return world.query_sphere(centers[i], QUERY_RADIUS).size();
+    });
+
+    std::vector<RigidBody*> results;
+    run("reused vector", [&](int i) {
+        return world.query_sphere(centers[i], QUERY_RADIUS, results);
+    });
+
+    run("visitor", [&](int i) {
+        float total_mass = 0.0f;
+        size_t count = world.visit_sphere(centers[i], QUERY_RADIUS, [&](RigidBody* body) {
+            total_mass += body->mass();
+            return true;
+        });
+        bench::do_not_optimize(total_mass);
+        return count;
+    });
+
+    return 0;
+}
@@ -0,0 +1,134 @@
+// Measures test_collision throughput for each of the 3x3 shape combinations.
+// Shapes sit in contiguous arrays the way the body store keeps them; roughly
+// half of the pairs overlap. Then each shape against rolling height fields of
+// growing size, whose cost should only grow with the BVH depth.
+
+#include "bench.hpp"
+
+#include <engine/physics/collision.hpp>
+#include <engine/physics/height_field.hpp>
+
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+using namespace engine::physics;
+
+namespace {
+
+constexpr int PAIR_COUNT = 4096;
+constexpr int ITERATIONS = 200;
+
+const char* shape_name(ShapeType type) {
+    switch (type) {
+        case ShapeType::None:         return "none";
+        case ShapeType::Sphere:       return "sphere";
+        case ShapeType::AABB:         return "aabb";
+        case ShapeType::Capsule:      return "capsule";
+        case ShapeType::Mesh:         return "mesh";
+        case ShapeType::HeightField:  return "height_field";
+    }
+    return "unknown";
+}
+
+CollisionShape make_shape(ShapeType type, std::mt19937& rng) {
+    std::uniform_real_distribution<float> size_dist(0.3f, 0.8f);
+
+    switch (type) {
+        case ShapeType::Sphere:
+            return SphereShape(size_dist(rng));
+        case ShapeType::AABB:
+            return AABBShape(glm::vec3(size_dist(rng), size_dist(rng), size_dist(rng)));
+        case ShapeType::Capsule:
+            return CapsuleShape(size_dist(rng), 2.0f);
+        case ShapeType::None:
+        case ShapeType::Mesh:
+        case ShapeType::HeightField:
+            break;
+    }
+    return CollisionShape{};
+}
+
+void run(ShapeType type_a, ShapeType type_b) {
+    std::mt19937 rng(42);
+    std::uniform_real_distribution<float> offset_dist(-1.5f, 1.5f);
+
+    std::vector<CollisionShape> shapes_a, shapes_b;
+    std::vector<glm::vec3> positions_b;
+    for (int i = 0; i < PAIR_COUNT; ++i) {
+        shapes_a.push_back(make_shape(type_a, rng));
+        shapes_b.push_back(make_shape(type_b, rng));
+        positions_b.push_back(glm::vec3(offset_dist(rng), offset_dist(rng), offset_dist(rng)));
+    }
+
+    int hits = 0;
+    double ms = bench::measure_ms(ITERATIONS, [&]() {
+        hits = 0;
+        for (int i = 0; i < PAIR_COUNT; ++i) {
+            auto result = test_collision(shapes_a[i], glm::vec3(0.0f), shapes_b[i], positions_b[i]);
+            hits += result.collided ? 1 : 0;
+            bench::do_not_optimize(result);
+        }
+    });
+
+    std::printf("%-8s vs %-8s %8.2f ns/pair  %7.1f Mpairs/s  (%d/%d hit)\n",
+                shape_name(type_a), shape_name(type_b), ms * 1e6 / PAIR_COUNT,
+                PAIR_COUNT / (ms * 1e3), hits, PAIR_COUNT);
+}
+
+void run_height_field(ShapeType type, uint32_t samples) {
+    std::vector<float> heights(samples * samples);
+    for (uint32_t row = 0; row < samples; ++row) {
+        for (uint32_t column = 0; column < samples; ++column) {
+            heights[row * samples + column] = std::sin(column * 0.3f) * std::cos(row * 0.2f);
+        }
+    }
+    HeightField field(samples, samples, 1.0f, std::move(heights));
+    CollisionShape field_shape = HeightFieldShape(&field);
+
+    std::mt19937 rng(42);
+    std::uniform_real_distribution<float> xz_dist(0.0f, static_cast<float>(samples - 1));
+
+    std::vector<CollisionShape> shapes;
+    std::vector<glm::vec3> positions;
+    for (int i = 0; i < PAIR_COUNT; ++i) {
+        shapes.push_back(make_shape(type, rng));
+        float x = xz_dist(rng);
+        float z = xz_dist(rng);
+        positions.push_back(glm::vec3(x, field.height_at(x, z) + 0.3f, z));
+    }
+
+    int hits = 0;
+    double ms = bench::measure_ms(ITERATIONS, [&]() {
+        hits = 0;
+        for (int i = 0; i < PAIR_COUNT; ++i) {
+            auto result = test_collision(shapes[i], positions[i], field_shape, glm::vec3(0.0f));
+            hits += result.collided ? 1 : 0;
+            bench::do_not_optimize(result);
+        }
+    });
+
+    std::printf("%-8s vs %4ux%-4u field %8.2f ns/pair  %7.1f Mpairs/s  (%d/%d hit)\n",
+                shape_name(type), samples, samples, ms * 1e6 / PAIR_COUNT,
+                PAIR_COUNT / (ms * 1e3), hits, PAIR_COUNT);
+}
+
+}  // namespace
+
+int main() {
+    const ShapeType types[] = {ShapeType::Sphere, ShapeType::AABB, ShapeType::Capsule};
+
+    for (ShapeType type_a : types) {
+        for (ShapeType type_b : types) {
+            run(type_a, type_b);
+        }
+    }
+
+    for (ShapeType type : types) {
+        for (uint32_t samples : {17u, 129u, 1025u}) {
+            run_height_field(type, samples);
+        }
+    }
+    return 0;
+}
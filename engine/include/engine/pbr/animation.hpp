@@ -5,6 +5,8 @@
 #define GLM_ENABLE_EXPERIMENTAL
 #include <glm/gtc/quaternion.hpp>
 
+#include <cassert>
+#include <cstdint>
 #include <vector>
 #include <string>
 #include <memory>
@@ -30,6 +32,34 @@ struct ScaleKey {
     glm::vec3 value;
 };
 
+/// Spacing of a key track: evenly spaced keys (the common case for baked
+/// clips) are found with one division instead of a search
+struct KeySpacing {
+    float start = 0.0f;
+    float inv_step = 0.0f;  // 0 if the keys aren't evenly spaced
+};
+
+/// Key each track of a channel was last found at. Playback instances keep one
+/// per channel, so a lookup resumes where the previous frame's ended; a
+/// cursor is only a hint, any value gives the same result.
+struct ChannelCursor {
+    uint32_t position = 0;
+    uint32_t rotation = 0;
+    uint32_t scale = 0;
+};
+
+/// Error bounds of AnimationClip::compress: a key is dropped when
+/// interpolating between the keys kept around it, as quantized, rebuilds it
+/// within these. Translations and scales are quantized to 1/65535 of the
+/// clip's range, so a tolerance below half that step can't be met.
+struct AnimationCompressionSettings {
+    float position_tolerance = 0.001f;   // Model units
+    float rotation_tolerance = 0.0005f;  // Per quaternion component (about 0.06 degrees)
+    float scale_tolerance = 0.001f;
+};
+
+class CompressedAnimation;
+
 /// Animation channel for a single bone
 struct AnimationChannel {
     std::string bone_name;
@@ -38,12 +68,24 @@ struct AnimationChannel {
     std::vector<ScaleKey> scale_keys;
 
     /// Evaluate the channel at a given time and return the transformation matrix
-    glm::mat4 evaluate(float time) const;
+    glm::mat4 evaluate(float time, ChannelCursor* cursor = nullptr) const;
+
+    /// Evaluate the channel at a given time as translation, rotation and scale
+    void evaluate_trs(float time, glm::vec3& position, glm::quat& rotation, glm::vec3& scale,
+                      ChannelCursor* cursor = nullptr) const;
+
+    /// Detect evenly spaced key tracks (call after filling the keys;
+    /// AnimationClip::add_channel does)
+    void update_key_spacing();
 
 private:
-    glm::vec3 interpolate_position(float time) const;
-    glm::quat interpolate_rotation(float time) const;
-    glm::vec3 interpolate_scale(float time) const;
+    glm::vec3 interpolate_position(float time, uint32_t* cursor) const;
+    glm::quat interpolate_rotation(float time, uint32_t* cursor) const;
+    glm::vec3 interpolate_scale(float time, uint32_t* cursor) const;
+
+    KeySpacing _position_spacing;
+    KeySpacing _rotation_spacing;
+    KeySpacing _scale_spacing;
 };
 
 /// An animation clip containing multiple channels
@@ -55,24 +97,57 @@ public:
     const std::string& name() const { return _name; }
     float duration() const { return _duration; }
     float ticks_per_second() const { return _ticks_per_second; }
+    /// Channels by bone name. Once the clip is compressed they keep only
+    /// their names (their keys are empty, so AnimationChannel::evaluate
+    /// returns identity): sample through evaluate_channel instead.
     const std::vector<AnimationChannel>& channels() const { return _channels; }
 
+    /// Evaluate one channel at a given time (in ticks), from the compressed
+    /// keys when the clip is compressed
+    void evaluate_channel(size_t channel, float time, glm::vec3& position, glm::quat& rotation,
+                          glm::vec3& scale, ChannelCursor* cursor = nullptr) const;
+
     // Setters (for loading)
     void set_name(std::string name) { _name = std::move(name); }
     void set_duration(float duration) { _duration = duration; }
     void set_ticks_per_second(float tps) { _ticks_per_second = tps; }
+    /// Channels can't be added once compressed: the compressed keys only
+    /// cover the channels there were then (asserts, ignored in release)
     void add_channel(AnimationChannel channel) {
+        assert(!_compressed && "add_channel after compress");
+        if (_compressed) return;
+        channel.update_key_spacing();
         _channels.push_back(std::move(channel));
-        _cache_built = false;
+        _bound_hierarchy.reset();
     }
 
-    /// Apply animation to a skeleton at the given time
-    void apply(Skeleton& skeleton, float time) const;
+    /// Apply animation to a skeleton at the given time. cursors (one per
+    /// channel, resized as needed) speed up keyframe lookups for a playback
+    /// that keeps them from frame to frame.
+    void apply(Skeleton& skeleton, float time, std::vector<ChannelCursor>* cursors = nullptr) const;
 
     /// Sample bone transforms at given time (for blending)
-    void sample(float time, std::vector<glm::mat4>& out_transforms, const Skeleton& skeleton) const;
-
-    /// Build channel-to-node cache for a skeleton (call once per skeleton)
+    void sample(float time, std::vector<glm::mat4>& out_transforms, const Skeleton& skeleton,
+                std::vector<ChannelCursor>* cursors = nullptr) const;
+
+    /// Sample the local pose of every hierarchy node at given time (nodes
+    /// without a channel keep their rest pose), for blending before
+    /// Skeleton::apply_pose
+    void sample_pose(float time, const Skeleton& skeleton, LocalPose& out_pose,
+                     std::vector<ChannelCursor>* cursors = nullptr) const;
+
+    /// Replace the keys with a compressed copy (animation_compression.hpp):
+    /// fewer keys, quantized and stored per track type. Channels keep their
+    /// names but not their keys; sampling decodes the compressed data. Call
+    /// after all channels are added (add_channel refuses new ones after).
+    void compress(const AnimationCompressionSettings& settings = AnimationCompressionSettings());
+
+    /// Compressed keys, or null if the clip isn't compressed
+    const std::shared_ptr<const CompressedAnimation>& compressed() const { return _compressed; }
+    bool is_compressed() const { return _compressed != nullptr; }
+
+    /// Bind the channels to the skeleton's hierarchy nodes (done on first use;
+    /// rebuilt only when a clip is used with a different hierarchy)
     void build_cache(const Skeleton& skeleton) const;
 
 private:
@@ -80,12 +155,26 @@ private:
     float _duration = 0.0f;
     float _ticks_per_second = 25.0f;
     std::vector<AnimationChannel> _channels;
+    std::shared_ptr<const CompressedAnimation> _compressed;
 
-    // Cached channel name to index mapping (built lazily)
-    mutable std::unordered_map<std::string, size_t> _channel_index_cache;
-    mutable bool _cache_built = false;
+    // Channel index of each node of the bound hierarchy, -1 if not animated
+    // (built lazily, by name, once per hierarchy)
+    mutable std::weak_ptr<const SkeletonHierarchy> _bound_hierarchy;
+    mutable std::vector<int> _node_channels;
 };
 
+/// Blend two local poses of the same hierarchy: translations and scales are
+/// lerped, rotations nlerped along the shortest path. weight 0 gives from,
+/// 1 gives to (scaled per node by mask, if any); out_pose may be either input.
+void blend_poses(const LocalPose& from, const LocalPose& to, float weight, LocalPose& out_pose,
+                 const BoneMask* mask = nullptr);
+
+/// Layer the difference between an additive pose and its reference pose (the
+/// same source sampled at rest, e.g. frame 0) on top of base, scaled by weight
+/// and mask. out_pose may be base.
+void add_additive_pose(const LocalPose& base, const LocalPose& additive, const LocalPose& reference,
+                       float weight, LocalPose& out_pose, const BoneMask* mask = nullptr);
+
 /// Animation state machine for controlling animation playback
 class AnimationState {
 public:
@@ -95,6 +184,7 @@ public:
     void set_clip(std::shared_ptr<AnimationClip> clip) {
         _clip = clip;
         _current_time = 0.0f;
+        _cursors.clear();
     }
 
     /// Crossfade to a new animation clip over the specified duration
@@ -109,6 +199,10 @@ public:
     /// Apply current animation state to skeleton
     void apply(Skeleton& skeleton) const;
 
+    /// Sample current animation state (crossfade included) as a local pose,
+    /// for layering before Skeleton::apply_pose. False if there is no clip.
+    bool sample_pose(const Skeleton& skeleton, LocalPose& out_pose) const;
+
     /// Play the animation
     void play() { _playing = true; }
 
@@ -157,6 +251,14 @@ private:
     bool _prev_looping = true;
     float _blend_factor = 1.0f;  // 0 = fully prev, 1 = fully current
     float _blend_duration = 0.0f;
+
+    // Keyframe cursors of the current and previous clip (kept across frames)
+    mutable std::vector<ChannelCursor> _cursors;
+    mutable std::vector<ChannelCursor> _prev_cursors;
+
+    // Local poses sampled while crossfading (reused, so blending doesn't allocate)
+    mutable LocalPose _pose;
+    mutable LocalPose _prev_pose;
 };
 
 }  // namespace engine::pbr
@@ -0,0 +1,88 @@
+#pragma once
+
+#include <engine/pbr/animation.hpp>
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace engine::pbr {
+
+/// Compressed keys of an animation clip, sampled without decompressing the
+/// whole clip:
+/// - keys that interpolating between their quantized neighbours rebuilds
+///   within the settings' tolerances are dropped (constant tracks keep a
+///   single key; a segment replaces at most 64 keys)
+/// - key times are 16 bits over the clip's length
+/// - translations and scales are 16 bits per component within the clip's
+///   bounds
+/// - rotations are 48 bits, smallest three: the index of the largest
+///   component plus the other three at 15 bits, the largest rebuilt from
+///   unit length
+/// Each track type is stored in its own arrays (times, then values), so a
+/// key costs 8 bytes instead of 16 or 20 for the loaded float keys.
+class CompressedAnimation {
+public:
+    /// Compress a clip's channels (duration in ticks)
+    static std::shared_ptr<CompressedAnimation> build(
+        const std::vector<AnimationChannel>& channels, float duration,
+        const AnimationCompressionSettings& settings);
+
+    /// Evaluate a channel at a given time (in ticks). cursor works as for
+    /// AnimationChannel::evaluate_trs.
+    void evaluate_trs(size_t channel, float time, glm::vec3& position, glm::quat& rotation,
+                      glm::vec3& scale, ChannelCursor* cursor = nullptr) const;
+
+    size_t channel_count() const { return _channels.size(); }
+
+    /// Keys kept over all tracks
+    size_t key_count() const {
+        return _position_times.size() + _rotation_times.size() + _scale_times.size();
+    }
+
+    /// Bytes used by the keys and track tables
+    size_t memory_usage() const;
+
+private:
+    struct Track {
+        uint32_t first_key = 0;
+        uint32_t key_count = 0;
+    };
+
+    struct ChannelTracks {
+        Track position;
+        Track rotation;
+        Track scale;
+    };
+
+    /// Index (within the track) of the key just before a quantized time
+    size_t find_key(const std::vector<uint16_t>& times, const Track& track, float time,
+                    uint32_t* cursor) const;
+
+    /// Key pair around a quantized time and the factor between them (first
+    /// == second when the time is outside the keys)
+    void find_keys(const std::vector<uint16_t>& times, const Track& track, float time, uint32_t* cursor,
+                   size_t& first, size_t& second, float& factor) const;
+
+    glm::vec3 decode_position(size_t key) const;
+    glm::quat decode_rotation(size_t key) const;
+    glm::vec3 decode_scale(size_t key) const;
+
+    std::vector<ChannelTracks> _channels;
+    float _time_scale = 0.0f;  // Quantized time units per tick
+
+    std::vector<uint16_t> _position_times;
+    std::vector<uint16_t> _position_values;  // 3 per key
+    glm::vec3 _position_min = glm::vec3(0.0f);
+    glm::vec3 _position_step = glm::vec3(0.0f);  // Clip bounds / 65535
+
+    std::vector<uint16_t> _rotation_times;
+    std::vector<uint16_t> _rotation_values;  // 3 per key (smallest three)
+
+    std::vector<uint16_t> _scale_times;
+    std::vector<uint16_t> _scale_values;  // 3 per key
+    glm::vec3 _scale_min = glm::vec3(0.0f);
+    glm::vec3 _scale_step = glm::vec3(0.0f);
+};
+
+}  // namespace engine::pbr
@@ -0,0 +1,161 @@
+#pragma once
+
+#include <engine/pbr/animation.hpp>
+#include <engine/pbr/skeleton.hpp>
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace engine::pbr {
+
+/// Clips placed along one parameter (e.g. idle at speed 0, run at speed 1),
+/// played in sync: the two clips around the parameter share one normalized
+/// phase, so their cycles line up while blending
+class BlendSpace1D {
+public:
+    BlendSpace1D() = default;
+
+    /// Place a clip at a parameter value (clips are kept sorted by position)
+    void add_clip(std::shared_ptr<AnimationClip> clip, float position);
+
+    /// Number of clips in the blend space
+    size_t clip_count() const { return _entries.size(); }
+
+    /// Parameter selecting the clips to blend (clamped to the outer clips)
+    void set_parameter(float value) { _parameter = value; }
+    float parameter() const { return _parameter; }
+
+    /// Playback phase in the blended cycle (0.0 to 1.0)
+    void set_phase(float phase) { _phase = phase; }
+    float phase() const { return _phase; }
+
+    /// Advance the shared phase by the blended cycle length
+    void update(float delta_time, float speed = 1.0f);
+
+    /// Sample the blended local pose. False if there are no clips.
+    bool sample_pose(const Skeleton& skeleton, LocalPose& out_pose) const;
+
+private:
+    struct Entry {
+        std::shared_ptr<AnimationClip> clip;
+        float position = 0.0f;
+        mutable std::vector<ChannelCursor> cursors;
+    };
+
+    /// The two entries around the parameter and the weight of the second
+    void find_blend(size_t& first, size_t& second, float& weight) const;
+
+    std::vector<Entry> _entries;
+    float _parameter = 0.0f;
+    float _phase = 0.0f;
+
+    // Second clip's pose while blending (reused across frames)
+    mutable LocalPose _scratch;
+};
+
+/// How a layer combines with the pose of the layers below it
+enum class LayerBlendMode : uint8_t {
+    Override,  // Blend toward the layer's pose by weight (and mask)
+    Additive   // Add the layer's difference from its reference pose
+};
+
+/// One layer of an AnimationGraph: a clip (with crossfades) or a 1-D blend
+/// space, a weight that can fade, an optional bone mask and a blend mode
+class AnimationLayer {
+public:
+    AnimationLayer() = default;
+
+    /// Play a clip on this layer, crossfading from the current one over
+    /// fade_duration (0 = switch at once)
+    void play(std::shared_ptr<AnimationClip> clip, float fade_duration = 0.0f, bool loop = true);
+
+    /// Drive this layer with a blend space instead of a clip
+    void set_blend_space(std::shared_ptr<BlendSpace1D> blend_space);
+    const std::shared_ptr<BlendSpace1D>& blend_space() const { return _blend_space; }
+
+    /// Clip playback of this layer (time, speed, looping)
+    AnimationState& state() { return _state; }
+    const AnimationState& state() const { return _state; }
+
+    /// Layer weight, set at once or faded over a duration
+    void set_weight(float weight) {
+        _weight = weight;
+        _target_weight = weight;
+        _fade_rate = 0.0f;
+    }
+    void fade_to(float weight, float duration);
+    float weight() const { return _weight; }
+    float target_weight() const { return _target_weight; }
+
+    /// Restrict the layer to some bones (null = whole skeleton)
+    void set_mask(std::shared_ptr<const BoneMask> mask) { _mask = std::move(mask); }
+    const std::shared_ptr<const BoneMask>& mask() const { return _mask; }
+
+    void set_mode(LayerBlendMode mode) { _mode = mode; }
+    LayerBlendMode mode() const { return _mode; }
+
+    /// Pose additive layers are measured against: the given clip at time 0
+    /// (null = the skeleton's rest pose)
+    void set_additive_reference(std::shared_ptr<AnimationClip> clip) {
+        _reference_clip = std::move(clip);
+        _reference_hierarchy.reset();
+    }
+
+    /// Advance playback and the weight fade
+    void update(float delta_time);
+
+    /// Sample the layer's local pose. False if it has nothing to play.
+    bool sample_pose(const Skeleton& skeleton, LocalPose& out_pose) const;
+
+    /// Reference pose for additive blending (cached per hierarchy)
+    const LocalPose& reference_pose(const Skeleton& skeleton) const;
+
+private:
+    AnimationState _state;
+    std::shared_ptr<BlendSpace1D> _blend_space;
+
+    float _weight = 1.0f;
+    float _target_weight = 1.0f;
+    float _fade_rate = 0.0f;  // Weight change per second toward the target
+
+    std::shared_ptr<const BoneMask> _mask;
+    LayerBlendMode _mode = LayerBlendMode::Override;
+
+    std::shared_ptr<AnimationClip> _reference_clip;
+    mutable std::weak_ptr<const SkeletonHierarchy> _reference_hierarchy;
+    mutable LocalPose _reference_pose;
+};
+
+/// Stack of animation layers evaluated bottom to top into one local pose.
+/// Every layer is sampled in local space and blended into the pose below
+/// it; the hierarchy pass that builds skinning matrices runs once at the
+/// end, so N layers cost N samplings plus one pass.
+class AnimationGraph {
+public:
+    AnimationGraph() = default;
+
+    /// Add a layer on top of the existing ones (layer 0 is the base pose).
+    /// References stay valid as more layers are added.
+    AnimationLayer& add_layer();
+
+    AnimationLayer& layer(size_t index) { return *_layers[index]; }
+    const AnimationLayer& layer(size_t index) const { return *_layers[index]; }
+    size_t layer_count() const { return _layers.size(); }
+
+    /// Advance every layer
+    void update(float delta_time);
+
+    /// Evaluate the layers and set the skeleton's bone transforms (left
+    /// untouched if no layer plays anything)
+    void apply(Skeleton& skeleton) const;
+
+private:
+    std::vector<std::unique_ptr<AnimationLayer>> _layers;
+
+    // Accumulated pose and the pose of the layer being added (reused)
+    mutable LocalPose _pose;
+    mutable LocalPose _layer_pose;
+};
+
+}  // namespace engine::pbr
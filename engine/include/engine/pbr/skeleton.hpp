@@ -1,6 +1,7 @@
 #pragma once
 
 #include <glm/glm.hpp>
+#include <glm/gtc/quaternion.hpp>
 
 #include <vector>
 #include <memory>
@@ -16,6 +17,73 @@ struct SkeletonNode {
     std::vector<SkeletonNode> children;
 };
 
+/// Local-space pose: translation, rotation and scale of every hierarchy node
+/// (indexed like SkeletonHierarchy), one array per component. Poses are
+/// blended in this form and turned into matrices once, by Skeleton::apply_pose.
+struct LocalPose {
+    std::vector<glm::vec3> translations;
+    std::vector<glm::quat> rotations;
+    std::vector<glm::vec3> scales;
+
+    size_t size() const { return translations.size(); }
+
+    /// Keeps capacity, so a pose reused every frame allocates only once
+    void resize(size_t node_count) {
+        translations.resize(node_count);
+        rotations.resize(node_count);
+        scales.resize(node_count);
+    }
+};
+
+/// Local transform T * R * S of a node, built directly instead of multiplying
+/// three matrices
+inline glm::mat4 compose_transform(const glm::vec3& translation, const glm::quat& rotation,
+                                   const glm::vec3& scale) {
+    glm::mat4 transform = glm::mat4_cast(rotation);
+    transform[0] *= scale.x;
+    transform[1] *= scale.y;
+    transform[2] *= scale.z;
+    transform[3] = glm::vec4(translation, 1.0f);
+    return transform;
+}
+
+/// Skeleton hierarchy flattened for pose evaluation: nodes in depth-first
+/// order, so every parent comes before its children and a pose is computed in
+/// one linear pass with no recursion or name lookups. Built once at load and
+/// shared by every instance of the skeleton.
+struct SkeletonHierarchy {
+    std::vector<std::string> names;           // Node names (for binding animation channels)
+    std::vector<int> parents;                 // Parent node index, -1 for the root
+    std::vector<glm::mat4> local_transforms;  // Rest local transform of each node
+    std::vector<int> bone_indices;            // Bone index of each node, -1 for non-bone nodes
+    LocalPose rest_pose;                      // local_transforms split into translation, rotation, scale
+
+    size_t node_count() const { return parents.size(); }
+
+    /// Index of the node with the given name, or -1
+    int find_node(const std::string& name) const;
+
+    /// Flatten a node tree (bone_index_map may be null: no node is a bone)
+    static std::shared_ptr<SkeletonHierarchy> build(
+        const SkeletonNode& root, const std::unordered_map<std::string, int>* bone_index_map);
+};
+
+/// Per-node weights of a layer over a hierarchy (1 = fully driven by the
+/// layer, 0 = untouched), e.g. upper body only for an attack layer
+struct BoneMask {
+    std::vector<float> weights;  // Indexed like SkeletonHierarchy
+
+    float weight(size_t node) const { return node < weights.size() ? weights[node] : 0.0f; }
+
+    /// weight for the named node and everything below it, 0 elsewhere (all 0
+    /// if there is no such node)
+    static BoneMask subtree(const SkeletonHierarchy& hierarchy, const std::string& root_name,
+                            float weight = 1.0f);
+
+    /// 1 - weight for every node (upper body mask into lower body mask)
+    BoneMask inverted() const;
+};
+
 class Skeleton {
 public:
     // Current bone transformations (global space, already multiplied by inverse bind pose)
@@ -30,6 +98,12 @@ public:
     // Root node of the skeleton hierarchy tree
     std::shared_ptr<SkeletonNode> root_node;
 
+    // Flattened root_node tree used to evaluate poses (shared across instances)
+    std::shared_ptr<SkeletonHierarchy> hierarchy;
+
+    // Scratch for pose evaluation: global transform of each hierarchy node
+    mutable std::vector<glm::mat4> node_transforms;
+
     Skeleton() = default;
 
     explicit Skeleton(size_t bone_count)
@@ -40,6 +114,15 @@ public:
         : transforms(bone_count, glm::mat4(1.0f)),
           bindpose(shared_bindpose) {}
 
+    /// Flatten root_node into hierarchy (call once after loading)
+    void build_hierarchy() {
+        hierarchy = root_node ? SkeletonHierarchy::build(*root_node, bone_index_map.get()) : nullptr;
+    }
+
+    /// Set transforms from a local pose of hierarchy's nodes: one pass
+    /// composing each node's matrix and concatenating it with its parent's
+    void apply_pose(const LocalPose& pose);
+
     size_t get_bone_count() const {
         return transforms.size();
     }
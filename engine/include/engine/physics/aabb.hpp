@@ -0,0 +1,60 @@
+#pragma once
+
+#include <glm/glm.hpp>
+
+#include <algorithm>
+
+namespace engine::physics {
+
+// World-space axis-aligned bounding box (used by broad phase and queries)
+struct AABB {
+    glm::vec3 min{0.0f};
+    glm::vec3 max{0.0f};
+
+    AABB() = default;
+    AABB(glm::vec3 min_corner, glm::vec3 max_corner) : min(min_corner), max(max_corner) {}
+
+    glm::vec3 center() const { return (min + max) * 0.5f; }
+    glm::vec3 extents() const { return max - min; }
+
+    // Touching boxes count as overlapping (broad phase must be conservative)
+    bool overlaps(const AABB& other) const {
+        return min.x <= other.max.x && max.x >= other.min.x &&
+               min.y <= other.max.y && max.y >= other.min.y &&
+               min.z <= other.max.z && max.z >= other.min.z;
+    }
+
+    bool contains(const AABB& other) const {
+        return min.x <= other.min.x && min.y <= other.min.y && min.z <= other.min.z &&
+               max.x >= other.max.x && max.y >= other.max.y && max.z >= other.max.z;
+    }
+
+    AABB merged(const AABB& other) const {
+        return AABB(glm::min(min, other.min), glm::max(max, other.max));
+    }
+
+    AABB expanded(float margin) const {
+        return AABB(min - glm::vec3(margin), max + glm::vec3(margin));
+    }
+
+    // Insertion cost metric for the dynamic tree
+    float surface_area() const {
+        glm::vec3 d = max - min;
+        return 2.0f * (d.x * d.y + d.y * d.z + d.z * d.x);
+    }
+
+    // Slab test against a ray (inv_direction = 1 / direction per component)
+    bool intersects_ray(glm::vec3 origin, glm::vec3 inv_direction, float max_dist) const {
+        float t_min = 0.0f;
+        float t_max = max_dist;
+        for (int axis = 0; axis < 3; ++axis) {
+            float t1 = (min[axis] - origin[axis]) * inv_direction[axis];
+            float t2 = (max[axis] - origin[axis]) * inv_direction[axis];
+            t_min = std::max(t_min, std::min(t1, t2));
+            t_max = std::min(t_max, std::max(t1, t2));
+        }
+        return t_min <= t_max;
+    }
+};
+
+}  // namespace engine::physics
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <engine/physics/aabb.hpp>
+#include <engine/physics/collision_shape.hpp>
+
+#include <glm/glm.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace engine::physics {
+
+// One shape against many: overlap kernels over shapes kept in
+// structure-of-arrays columns, testing 8 (AVX), 4 (SSE2) or 1 pair per
+// instruction through the simd wrapper. They answer yes/no only (no contact
+// data), for gameplay checks such as projectiles against every enemy. Each
+// kernel clears hits, appends the indices of the overlapping shapes in
+// ascending order and returns how many it found; a reused hits vector keeps
+// its capacity, so steady-state calls don't allocate.
+
+// Spheres as columns (center and radius per sphere, world space)
+struct SphereBatch {
+    std::vector<float> center_x, center_y, center_z;
+    std::vector<float> radius;
+
+    size_t size() const { return radius.size(); }
+    void clear();
+    void reserve(size_t count);
+    void push_back(glm::vec3 center, float r);
+};
+
+// Boxes as columns (world-space min and max corners)
+struct AABBBatch {
+    std::vector<float> min_x, min_y, min_z;
+    std::vector<float> max_x, max_y, max_z;
+
+    size_t size() const { return min_x.size(); }
+    void clear();
+    void reserve(size_t count);
+    void push_back(const AABB& box);
+};
+
+// Spheres strictly overlapping the sphere (same test as test_sphere_sphere)
+size_t overlap_sphere_spheres(glm::vec3 center, float radius, const SphereBatch& spheres,
+                              std::vector<uint32_t>& hits);
+
+// Spheres strictly overlapping the vertical capsule at position (same test as
+// test_capsule_sphere, which may round differently exactly at the surface)
+size_t overlap_capsule_spheres(const CapsuleShape& capsule, glm::vec3 position,
+                               const SphereBatch& spheres, std::vector<uint32_t>& hits);
+
+// Boxes overlapping the box, touching included (same test as AABB::overlaps)
+size_t overlap_aabb_aabbs(const AABB& box, const AABBBatch& boxes, std::vector<uint32_t>& hits);
+
+}  // namespace engine::physics
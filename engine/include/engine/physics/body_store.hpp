@@ -0,0 +1,161 @@
+#pragma once
+
+#include <engine/physics/collision_shape.hpp>
+
+#include <glm/glm.hpp>
+
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+namespace engine::physics {
+
+class RigidBody;
+
+// Body state bits (BodyState::flags / BodyStore::flags)
+enum BodyFlag : uint32_t {
+    BODY_STATIC = 1u << 0,       // Never moves, infinite mass
+    BODY_USE_GRAVITY = 1u << 1,
+    BODY_TRIGGER = 1u << 2,      // Detects overlap but is never resolved
+    BODY_SLEEPING = 1u << 3,     // At rest: not integrated, only woken by contact or by hand
+    BODY_NEVER_SLEEP = 1u << 4   // Opts out of sleeping (e.g. gameplay-driven bodies)
+};
+
+// Collision filtering: a pair is only generated when each body's layer bits
+// intersect the other body's mask. Queries test body layers against a mask.
+constexpr uint32_t DEFAULT_COLLISION_LAYER = 1u << 0;
+constexpr uint32_t ALL_COLLISION_LAYERS = 0xFFFFFFFFu;
+
+// Stable reference to a body in a BodyStore. Survives other bodies being
+// removed; a stale handle is detected through the generation counter.
+struct BodyHandle {
+    static constexpr uint32_t INVALID_SLOT = std::numeric_limits<uint32_t>::max();
+
+    uint32_t slot = INVALID_SLOT;
+    uint32_t generation = 0;
+
+    bool valid() const { return slot != INVALID_SLOT; }
+    bool operator==(const BodyHandle& other) const {
+        return slot == other.slot && generation == other.generation;
+    }
+    bool operator!=(const BodyHandle& other) const { return !(*this == other); }
+};
+
+// Simulation state of one body, used to move bodies in and out of a store
+struct BodyState {
+    glm::vec3 position{0.0f};
+    glm::vec3 velocity{0.0f};
+    glm::vec3 force{0.0f};         // Accumulated over the step, cleared by integration
+    float mass = 1.0f;
+    float inv_mass = 1.0f;         // 0 for static bodies
+    float drag = 0.1f;             // Linear drag coefficient
+    float restitution = 0.0f;      // Bounciness (0 = no bounce, 1 = perfect bounce)
+    uint32_t flags = BODY_USE_GRAVITY;
+    uint32_t collision_layer = DEFAULT_COLLISION_LAYER;  // Layer bits this body is on
+    uint32_t collision_mask = ALL_COLLISION_LAYERS;      // Layers it collides with
+    CollisionShape shape;          // ShapeType::None until a shape is set
+};
+
+// Structure-of-arrays storage for every body in a world. Columns are dense
+// (removal swaps the last body into the hole) so the integrator and broad
+// phase stream through contiguous memory; handles map to dense indices
+// through a slot table.
+class BodyStore {
+public:
+    BodyStore() = default;
+
+    BodyHandle create(const BodyState& state, RigidBody* owner);
+
+    // Remove a body and return its final state
+    BodyState destroy(BodyHandle handle);
+
+    void clear();
+
+    size_t size() const { return owners.size(); }
+    bool contains(BodyHandle handle) const;
+
+    uint32_t dense_index(BodyHandle handle) const { return _slots[handle.slot].dense; }
+    BodyHandle handle(uint32_t index) const { return BodyHandle{slots[index], _slots[slots[index]].generation}; }
+    uint32_t dense_index_of_slot(uint32_t slot) const { return _slots[slot].dense; }
+
+    BodyState get_state(uint32_t index) const;
+    void set_state(uint32_t index, const BodyState& state);
+
+    glm::vec3 position(uint32_t index) const {
+        return glm::vec3(pos_x[index], pos_y[index], pos_z[index]);
+    }
+    void set_position(uint32_t index, glm::vec3 p) {
+        pos_x[index] = p.x;
+        pos_y[index] = p.y;
+        pos_z[index] = p.z;
+    }
+
+    // Position at the start of the last fixed step (for render interpolation)
+    glm::vec3 previous_position(uint32_t index) const {
+        return glm::vec3(prev_x[index], prev_y[index], prev_z[index]);
+    }
+    void save_previous_positions() {
+        prev_x = pos_x;
+        prev_y = pos_y;
+        prev_z = pos_z;
+    }
+
+    glm::vec3 velocity(uint32_t index) const {
+        return glm::vec3(vel_x[index], vel_y[index], vel_z[index]);
+    }
+    void set_velocity(uint32_t index, glm::vec3 v) {
+        vel_x[index] = v.x;
+        vel_y[index] = v.y;
+        vel_z[index] = v.z;
+    }
+
+    glm::vec3 force(uint32_t index) const {
+        return glm::vec3(force_x[index], force_y[index], force_z[index]);
+    }
+    void set_force(uint32_t index, glm::vec3 f) {
+        force_x[index] = f.x;
+        force_y[index] = f.y;
+        force_z[index] = f.z;
+    }
+
+    // Updates the flag column and the derived per-lane scales
+    void set_flags(uint32_t index, uint32_t new_flags);
+
+    bool is_static(uint32_t index) const { return (flags[index] & BODY_STATIC) != 0; }
+    bool is_trigger(uint32_t index) const { return (flags[index] & BODY_TRIGGER) != 0; }
+    bool is_sleeping(uint32_t index) const { return (flags[index] & BODY_SLEEPING) != 0; }
+
+    // Semi-implicit Euler over all bodies (SIMD, 4-8 bodies per instruction)
+    void integrate(float delta, glm::vec3 gravity);
+
+    // Dense columns (index = dense body index)
+    std::vector<float> pos_x, pos_y, pos_z;
+    std::vector<float> prev_x, prev_y, prev_z;
+    std::vector<float> vel_x, vel_y, vel_z;
+    std::vector<float> force_x, force_y, force_z;
+    std::vector<float> mass;
+    std::vector<float> inv_mass;
+    std::vector<float> drag;
+    std::vector<float> restitution;
+    std::vector<float> gravity_scale;  // 1 if dynamic, awake and affected by gravity, else 0
+    std::vector<float> motion_scale;   // 1 if dynamic and awake, 0 if static or sleeping
+    std::vector<float> sleep_time;     // Seconds spent below the sleep velocity
+    std::vector<uint32_t> flags;
+    std::vector<uint32_t> collision_layers;
+    std::vector<uint32_t> collision_masks;
+    std::vector<CollisionShape> shapes;    // Inline values (no per-body allocation)
+    std::vector<RigidBody*> owners;
+    std::vector<int> tree_proxies;     // DynamicAABBTree proxy per body
+    std::vector<uint32_t> slots;       // Dense index -> slot (for swap-remove)
+
+private:
+    struct Slot {
+        uint32_t dense = 0;
+        uint32_t generation = 0;
+    };
+
+    std::vector<Slot> _slots;
+    std::vector<uint32_t> _free_slots;
+};
+
+}  // namespace engine::physics
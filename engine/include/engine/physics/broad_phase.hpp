@@ -0,0 +1,100 @@
+#pragma once
+
+#include <engine/physics/aabb.hpp>
+
+#include <cmath>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace engine::physics {
+
+// Per-body input to the broad phase (index in the proxy array = body index)
+struct BroadPhaseProxy {
+    AABB bounds;
+    bool enabled = false;     // False for bodies without a shape
+    bool is_static = false;
+    bool is_sleeping = false;
+    bool is_moved = false;    // Static body moved by hand since the last step
+    uint32_t collision_layer = 0;
+    uint32_t collision_mask = 0;
+};
+
+// Candidate pair of body indices (always a < b)
+struct BodyPair {
+    uint32_t a = 0;
+    uint32_t b = 0;
+
+    bool operator<(const BodyPair& other) const {
+        return a != other.a ? a < other.a : b < other.b;
+    }
+    bool operator==(const BodyPair& other) const {
+        return a == other.a && b == other.b;
+    }
+};
+
+enum class BroadPhaseType {
+    BruteForce,     // O(n^2) reference implementation
+    SpatialHash,    // Uniform grid hashed into buckets (default)
+    SweepAndPrune   // Persistent sorted endpoint lists, best for coherent motion
+};
+
+// A body that blew up (NaN or infinite bounds) can't touch anything; every
+// broad phase skips it like a disabled one
+inline bool has_finite_bounds(const BroadPhaseProxy& proxy) {
+    const glm::vec3& lo = proxy.bounds.min;
+    const glm::vec3& hi = proxy.bounds.max;
+    return std::isfinite(lo.x) && std::isfinite(lo.y) && std::isfinite(lo.z) &&
+           std::isfinite(hi.x) && std::isfinite(hi.y) && std::isfinite(hi.z);
+}
+
+// Pair filter shared by all broad phase implementations: each body's layer
+// has to be in the other's mask, two static bodies never collide, and at
+// least one body has to have moved (sleeping bodies and static bodies
+// nobody moved by hand stay put)
+inline bool should_test_pair(const BroadPhaseProxy& a, const BroadPhaseProxy& b) {
+    if (!a.enabled || !b.enabled) return false;
+    if ((a.collision_layer & b.collision_mask) == 0 || (b.collision_layer & a.collision_mask) == 0) return false;
+    if (a.is_static && b.is_static) return false;
+    bool a_resting = a.is_sleeping || (a.is_static && !a.is_moved);
+    bool b_resting = b.is_sleeping || (b.is_static && !b.is_moved);
+    return !(a_resting && b_resting);
+}
+
+// Finds pairs of bodies whose bounds overlap. Implementations may keep state
+// between steps: add_proxy and remove_proxy report bodies added and removed,
+// reset() drops everything (all bodies cleared).
+class BroadPhase {
+public:
+    virtual ~BroadPhase() = default;
+
+    virtual BroadPhaseType type() const = 0;
+
+    // Body set changed, drop any per-body persistent state
+    virtual void reset() {}
+
+    // A body was appended at index (its bounds arrive with the next
+    // find_pairs). Implementations that can't insert one body just reset.
+    virtual void add_proxy(uint32_t /*index*/) { reset(); }
+
+    // The body at index was removed and the last body (index last) moved
+    // into its place, as BodyStore does
+    virtual void remove_proxy(uint32_t /*index*/, uint32_t /*last*/) { reset(); }
+
+    // Append every overlapping, filter-passing pair (order is implementation defined)
+    virtual void find_pairs(const std::vector<BroadPhaseProxy>& proxies,
+                            std::vector<BodyPair>& out_pairs) = 0;
+};
+
+class BruteForceBroadPhase : public BroadPhase {
+public:
+    BroadPhaseType type() const override { return BroadPhaseType::BruteForce; }
+
+    void find_pairs(const std::vector<BroadPhaseProxy>& proxies,
+                    std::vector<BodyPair>& out_pairs) override;
+};
+
+// Create one of the built-in broad phase implementations
+std::unique_ptr<BroadPhase> create_broad_phase(BroadPhaseType type);
+
+}  // namespace engine::physics
@@ -0,0 +1,143 @@
+#pragma once
+
+#include <engine/physics/aabb.hpp>
+#include <engine/physics/collision_shape.hpp>
+#include <engine/physics/rigid_body.hpp>
+
+#include <glm/glm.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace engine::physics {
+
+class PhysicsWorld;
+
+struct CharacterSettings {
+    float radius = 0.4f;
+    float height = 1.8f;                 // Total capsule height (feet to head)
+    float step_height = 0.3f;            // Ledges up to this high are stepped onto
+    float max_slope_cos = 0.7f;          // Cosine of the steepest walkable slope (~45 degrees)
+    float skin_width = 0.01f;            // Gap kept to surfaces so sweeps never start touching
+    float ground_probe = 0.05f;          // How far below the feet ground still counts
+    int max_slide_iterations = 4;
+    uint32_t collision_mask = ALL_COLLISION_LAYERS;  // What the character is blocked by
+};
+
+// Kinematic character: a vertical capsule moved with sweeps instead of being
+// simulated. Each move slides along whatever it hits, steps up ledges of up
+// to step_height, stays glued to the ground walking down slopes and steps, and
+// falls under the world's gravity when there's no ground. The capsule is also
+// registered as a static body, so other characters, queries and dynamic
+// bodies see it. Positions are at the feet (bottom of the capsule).
+class CharacterController {
+public:
+    CharacterController() = default;
+    explicit CharacterController(const CharacterSettings& settings);
+
+    // Register with / leave a world (the body is owned by the controller)
+    void add_to_world(PhysicsWorld& world);
+    void remove_from_world();
+
+    const CharacterSettings& settings() const { return _settings; }
+    void set_settings(const CharacterSettings& settings);
+
+    glm::vec3 position() const { return _position; }
+    void set_position(glm::vec3 position);  // Teleport (no sweep)
+
+    // Horizontal velocity wanted for the next move (y is ignored)
+    glm::vec3 desired_velocity() const { return _desired_velocity; }
+    void set_desired_velocity(glm::vec3 velocity) { _desired_velocity = velocity; }
+
+    // Start moving up (ignored while airborne)
+    void jump(float speed);
+
+    // Actual velocity over the last move, and the ground found after it
+    glm::vec3 velocity() const { return _velocity; }
+    bool is_grounded() const { return _grounded; }
+    glm::vec3 ground_normal() const { return _ground_normal; }
+
+    // Move by the desired velocity over delta against the world as it is
+    void move(PhysicsWorld& world, float delta);
+
+    // Move many controllers in one call (a crowd of enemies). The broad phase
+    // runs once for the whole batch: every swept capsule's bounds go through
+    // a single traversal of the query tree, then each controller slides
+    // against its own candidate list. Controllers move one after another, so
+    // later ones see earlier ones at their new positions; the order is the
+    // array order, which keeps results deterministic.
+    static void move_all(PhysicsWorld& world, CharacterController* const* controllers,
+                         size_t count, float delta);
+
+    // Capsule body (layer, mask and user data are free for the game to set)
+    RigidBody& body() { return _body; }
+    const RigidBody& body() const { return _body; }
+
+private:
+    // Extra room around a move's candidate query: move_all queries the whole
+    // batch before anyone moves, so bodies moved since (other characters
+    // earlier in the same batch) may sit slightly outside their queried bounds.
+    // Covers 15 m/s at 60 steps per second.
+    static constexpr float CANDIDATE_MARGIN = 0.25f;
+
+    // First contact of a sweep against the candidates
+    struct Hit {
+        float time = 1.0f;
+        glm::vec3 point{0.0f};
+        glm::vec3 normal{0.0f};
+    };
+
+    // This move's motion, split so the step-up can retry the horizontal part
+    struct Move {
+        glm::vec3 horizontal{0.0f};
+        glm::vec3 vertical{0.0f};
+        bool was_grounded = false;
+    };
+
+    // Per-thread scratch for move_all (reused every call)
+    struct Batch {
+        std::vector<Move> moves;
+        std::vector<AABB> bounds;
+        std::vector<uint32_t> masks;
+        std::vector<uint32_t> offsets;
+        std::vector<uint32_t> indices;
+    };
+    static thread_local Batch s_batch;
+
+    // Apply gravity and work out the motion over delta
+    Move begin_move(float gravity, float delta);
+    // Box holding everything the capsule can touch over a motion
+    AABB candidate_bounds(glm::vec3 motion) const;
+    // Drop candidates that never block (our own capsule, triggers)
+    void filter_candidates(const PhysicsWorld& world, std::vector<uint32_t>& candidates) const;
+    // Depenetrate, slide, step and probe the ground against the candidates
+    void finish_move(const PhysicsWorld& world, const std::vector<uint32_t>& candidates,
+                     const Move& motion, float delta);
+    glm::vec3 depenetrate(const PhysicsWorld& world, const std::vector<uint32_t>& candidates,
+                          glm::vec3 position) const;
+    bool sweep(const PhysicsWorld& world, const std::vector<uint32_t>& candidates,
+               glm::vec3 start, glm::vec3 motion, Hit& hit) const;
+    // Moves position; returns whether something too steep to walk on was hit
+    // (the first such contact goes to wall)
+    bool slide(const PhysicsWorld& world, const std::vector<uint32_t>& candidates,
+               glm::vec3& position, glm::vec3 motion, bool walking, Hit& wall) const;
+    bool probe_ground(const PhysicsWorld& world, const std::vector<uint32_t>& candidates,
+                      glm::vec3 start, float distance, glm::vec3& ground, Hit& hit) const;
+    bool surface_below(const PhysicsWorld& world, const std::vector<uint32_t>& candidates,
+                       glm::vec3 origin, float max_dist, glm::vec3& normal) const;
+    bool is_walkable(glm::vec3 normal) const { return normal.y >= _settings.max_slope_cos; }
+    CapsuleShape capsule() const;
+
+    CharacterSettings _settings;
+    glm::vec3 _position{0.0f};
+    glm::vec3 _desired_velocity{0.0f};
+    glm::vec3 _velocity{0.0f};
+    float _vertical_speed = 0.0f;
+    bool _grounded = false;
+    glm::vec3 _ground_normal{0.0f, 1.0f, 0.0f};
+    RigidBody _body;
+    std::vector<uint32_t> _candidates;   // Candidates of the current move
+};
+
+}  // namespace engine::physics
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <engine/physics/aabb.hpp>
 #include <engine/physics/collision_shape.hpp>
 
 #include <glm/glm.hpp>
@@ -8,11 +9,26 @@ namespace engine::physics {
 
 struct CollisionResult {
     bool collided = false;
-    glm::vec3 normal{0.0f};       // Collision normal (direction to separate A from B)
+    glm::vec3 normal{0.0f};       // Collision normal (from A towards B)
     float penetration = 0.0f;     // Overlap depth
     glm::vec3 contact_point{0.0f};
 };
 
+// Result of a swept test: first contact along a motion
+struct SweepResult {
+    bool hit = false;
+    float time = 0.0f;            // Fraction of the motion at first contact (0 if already touching)
+    glm::vec3 normal{0.0f};       // Surface normal of the static shape at the contact
+    glm::vec3 contact_point{0.0f};
+};
+
+// Result of a ray test
+struct RayResult {
+    bool hit = false;
+    float distance = 0.0f;        // Along the ray direction (in units of its length)
+    glm::vec3 normal{0.0f};       // Surface normal at the hit point
+};
+
 // Sphere vs Sphere collision test
 CollisionResult test_sphere_sphere(
     const SphereShape& a, glm::vec3 pos_a,
@@ -43,9 +59,90 @@ CollisionResult test_capsule_sphere(
     const CapsuleShape& cap, glm::vec3 cap_pos,
     const SphereShape& sphere, glm::vec3 sphere_pos);
 
+// Convex shape (sphere, AABB or capsule) vs the triangles of a static mesh
+// or height field; reports the deepest triangle contact
+CollisionResult test_shape_mesh(
+    const CollisionShape& shape, glm::vec3 shape_pos,
+    const MeshShape& mesh, glm::vec3 mesh_pos);
+
+CollisionResult test_shape_height_field(
+    const CollisionShape& shape, glm::vec3 shape_pos,
+    const HeightFieldShape& field, glm::vec3 field_pos);
+
 // Generic collision test dispatcher (uses shape types to call appropriate test)
 CollisionResult test_collision(
     const CollisionShape& a, glm::vec3 pos_a,
     const CollisionShape& b, glm::vec3 pos_b);
 
+// Swept sphere tests: a sphere of the given radius moves from start to
+// start + motion against a shape at rest. Exact (Minkowski sum of the shape
+// and the sphere, intersected with the motion segment).
+SweepResult sweep_sphere_sphere(
+    float radius, glm::vec3 start, glm::vec3 motion,
+    const SphereShape& sphere, glm::vec3 sphere_pos);
+
+SweepResult sweep_sphere_aabb(
+    float radius, glm::vec3 start, glm::vec3 motion,
+    const AABBShape& aabb, glm::vec3 aabb_pos);
+
+SweepResult sweep_sphere_capsule(
+    float radius, glm::vec3 start, glm::vec3 motion,
+    const CapsuleShape& cap, glm::vec3 cap_pos);
+
+SweepResult sweep_sphere_mesh(
+    float radius, glm::vec3 start, glm::vec3 motion,
+    const MeshShape& mesh, glm::vec3 mesh_pos);
+
+SweepResult sweep_sphere_height_field(
+    float radius, glm::vec3 start, glm::vec3 motion,
+    const HeightFieldShape& field, glm::vec3 field_pos);
+
+// Generic swept sphere dispatcher
+SweepResult sweep_sphere(
+    float radius, glm::vec3 start, glm::vec3 motion,
+    const CollisionShape& shape, glm::vec3 shape_pos);
+
+// Swept vertical capsule (characters): the capsule moves from start to
+// start + motion against a shape at rest. Its center is swept against the
+// shape grown by the capsule's axis, which keeps every case exact.
+SweepResult sweep_capsule(
+    const CapsuleShape& capsule, glm::vec3 start, glm::vec3 motion,
+    const CollisionShape& shape, glm::vec3 shape_pos);
+
+// Segment from start to end vs shape (a sweep with zero radius)
+SweepResult test_segment(
+    glm::vec3 start, glm::vec3 end,
+    const CollisionShape& shape, glm::vec3 shape_pos);
+
+// Exact ray tests against origin + t * direction for t in (0, max_dist].
+// A ray starting inside a shape does not hit it.
+RayResult raycast_sphere(
+    glm::vec3 origin, glm::vec3 direction, float max_dist,
+    const SphereShape& sphere, glm::vec3 sphere_pos);
+
+RayResult raycast_aabb(
+    glm::vec3 origin, glm::vec3 direction, float max_dist,
+    const AABBShape& aabb, glm::vec3 aabb_pos);
+
+RayResult raycast_capsule(
+    glm::vec3 origin, glm::vec3 direction, float max_dist,
+    const CapsuleShape& cap, glm::vec3 cap_pos);
+
+// Triangles are hit from either side
+RayResult raycast_mesh(
+    glm::vec3 origin, glm::vec3 direction, float max_dist,
+    const MeshShape& mesh, glm::vec3 mesh_pos);
+
+RayResult raycast_height_field(
+    glm::vec3 origin, glm::vec3 direction, float max_dist,
+    const HeightFieldShape& field, glm::vec3 field_pos);
+
+// Generic ray dispatcher
+RayResult raycast_shape(
+    glm::vec3 origin, glm::vec3 direction, float max_dist,
+    const CollisionShape& shape, glm::vec3 shape_pos);
+
+// World-space bounds of a shape placed at the given body position
+AABB compute_aabb(const CollisionShape& shape, glm::vec3 position);
+
 }  // namespace engine::physics
@@ -2,51 +2,52 @@
 
 #include <glm/glm.hpp>
 
+#include <cstdint>
+
 namespace engine::physics {
 
-enum class ShapeType {
+enum class ShapeType : uint8_t {
+    None,     // Body without a shape (never collides)
     Sphere,
     AABB,
-    Capsule
+    Capsule,
+    Mesh,         // Static triangle mesh (static bodies only)
+    HeightField   // Static terrain (static bodies only)
 };
 
-struct CollisionShape {
-    ShapeType type;
-    glm::vec3 offset{0.0f};  // Local offset from entity position
+constexpr int SHAPE_TYPE_COUNT = 6;
 
-    explicit CollisionShape(ShapeType t) : type(t) {}
-    virtual ~CollisionShape() = default;
-};
+class TriangleMesh;
+class HeightField;
 
-struct SphereShape : CollisionShape {
+// Shape parameters are plain values. Each one starts with its offset, so the
+// offset can be read through any member of CollisionShape's union.
+struct SphereShape {
+    glm::vec3 offset{0.0f};  // Local offset from entity position
     float radius = 0.5f;
 
-    SphereShape() : CollisionShape(ShapeType::Sphere) {}
-    explicit SphereShape(float r) : CollisionShape(ShapeType::Sphere), radius(r) {}
-    SphereShape(float r, glm::vec3 off) : CollisionShape(ShapeType::Sphere), radius(r) {
-        offset = off;
-    }
+    SphereShape() = default;
+    explicit SphereShape(float r) : radius(r) {}
+    SphereShape(float r, glm::vec3 off) : offset(off), radius(r) {}
 };
 
-struct AABBShape : CollisionShape {
+struct AABBShape {
+    glm::vec3 offset{0.0f};  // Local offset from entity position
     glm::vec3 half_extents{0.5f};  // Half-size in each axis
 
-    AABBShape() : CollisionShape(ShapeType::AABB) {}
-    explicit AABBShape(glm::vec3 half) : CollisionShape(ShapeType::AABB), half_extents(half) {}
-    AABBShape(glm::vec3 half, glm::vec3 off) : CollisionShape(ShapeType::AABB), half_extents(half) {
-        offset = off;
-    }
+    AABBShape() = default;
+    explicit AABBShape(glm::vec3 half) : half_extents(half) {}
+    AABBShape(glm::vec3 half, glm::vec3 off) : offset(off), half_extents(half) {}
 };
 
-struct CapsuleShape : CollisionShape {
+struct CapsuleShape {
+    glm::vec3 offset{0.0f};  // Local offset from entity position
     float radius = 0.5f;
     float height = 2.0f;  // Total height (including hemispherical caps)
 
-    CapsuleShape() : CollisionShape(ShapeType::Capsule) {}
-    CapsuleShape(float r, float h) : CollisionShape(ShapeType::Capsule), radius(r), height(h) {}
-    CapsuleShape(float r, float h, glm::vec3 off) : CollisionShape(ShapeType::Capsule), radius(r), height(h) {
-        offset = off;
-    }
+    CapsuleShape() = default;
+    CapsuleShape(float r, float h) : radius(r), height(h) {}
+    CapsuleShape(float r, float h, glm::vec3 off) : offset(off), radius(r), height(h) {}
 
     // Height of the cylindrical portion (excluding caps)
     float cylinder_height() const { return height - 2.0f * radius; }
@@ -55,4 +56,50 @@ struct CapsuleShape : CollisionShape {
     float half_cylinder_height() const { return cylinder_height() * 0.5f; }
 };
 
+// Mesh and height field shapes reference shared, immutable geometry that
+// must outlive the bodies using it
+struct MeshShape {
+    glm::vec3 offset{0.0f};  // Local offset from entity position
+    const TriangleMesh* mesh = nullptr;
+
+    MeshShape() = default;
+    explicit MeshShape(const TriangleMesh* m) : mesh(m) {}
+    MeshShape(const TriangleMesh* m, glm::vec3 off) : offset(off), mesh(m) {}
+};
+
+struct HeightFieldShape {
+    glm::vec3 offset{0.0f};  // Local offset from entity position (sample 0, 0)
+    const HeightField* field = nullptr;
+
+    HeightFieldShape() = default;
+    explicit HeightFieldShape(const HeightField* f) : field(f) {}
+    HeightFieldShape(const HeightField* f, glm::vec3 off) : offset(off), field(f) {}
+};
+
+// Value-type shape: a tag plus the parameters of the active shape, stored
+// inline (in the body store's shape column) instead of behind a pointer.
+// Pair tests dispatch through a table indexed by both tags.
+struct CollisionShape {
+    ShapeType type = ShapeType::None;
+    union {
+        SphereShape sphere;
+        AABBShape aabb;
+        CapsuleShape capsule;
+        MeshShape mesh;
+        HeightFieldShape height_field;
+    };
+
+    CollisionShape() : sphere() {}
+    CollisionShape(const SphereShape& s) : type(ShapeType::Sphere), sphere(s) {}
+    CollisionShape(const AABBShape& a) : type(ShapeType::AABB), aabb(a) {}
+    CollisionShape(const CapsuleShape& c) : type(ShapeType::Capsule), capsule(c) {}
+    CollisionShape(const MeshShape& m) : type(ShapeType::Mesh), mesh(m) {}
+    CollisionShape(const HeightFieldShape& h) : type(ShapeType::HeightField), height_field(h) {}
+
+    bool empty() const { return type == ShapeType::None; }
+
+    // Local offset from entity position (shared first member of every shape)
+    glm::vec3 offset() const { return sphere.offset; }
+};
+
 }  // namespace engine::physics
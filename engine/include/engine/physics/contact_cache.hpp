@@ -0,0 +1,49 @@
+#pragma once
+
+#include <glm/glm.hpp>
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace engine::physics {
+
+// Contact of one body pair, kept from one step to the next for warm-starting
+struct CachedContact {
+    uint64_t key = 0;             // ContactCache::make_key of the two body slots
+    glm::vec3 normal{0.0f};       // From the lower slot body towards the higher one
+    glm::vec3 point{0.0f};
+    float normal_impulse = 0.0f;  // Accumulated by the solver (>= 0)
+};
+
+// Persistent pair cache keyed by body slots, which (unlike dense indices)
+// survive other bodies being removed. Contacts stored during a step become
+// the lookup set of the next step; pairs that stopped touching drop out.
+// Both sets are flat arrays, the lookup set sorted by key.
+class ContactCache {
+public:
+    static uint64_t make_key(uint32_t slot_a, uint32_t slot_b) {
+        if (slot_b < slot_a) std::swap(slot_a, slot_b);
+        return (static_cast<uint64_t>(slot_a) << 32) | slot_b;
+    }
+
+    // Contact of the pair from the previous step, or null
+    const CachedContact* find(uint64_t key) const;
+
+    // Record this step's contacts (any order), then end_step() publishes them
+    void begin_step() { _current.clear(); }
+    void store(const CachedContact& contact) { _current.push_back(contact); }
+    void end_step();
+
+    // Forget every contact involving a body slot (the slot may be reused)
+    void remove_slot(uint32_t slot);
+
+    void clear();
+    size_t size() const { return _previous.size(); }
+
+private:
+    std::vector<CachedContact> _previous;  // Sorted by key
+    std::vector<CachedContact> _current;
+};
+
+}  // namespace engine::physics
@@ -0,0 +1,269 @@
+#pragma once
+
+#include <engine/physics/aabb.hpp>
+
+#include <glm/glm.hpp>
+
+#include <cstdint>
+#include <vector>
+
+namespace engine::physics {
+
+// Incrementally updated bounding volume hierarchy. Leaves store fat AABBs
+// (bounds grown by a margin and the predicted motion), so a moving body is
+// only re-inserted once it leaves its fat box. Inserts pick a sibling with the
+// surface area heuristic and rotations keep the tree balanced.
+class DynamicAABBTree {
+public:
+    static constexpr int NULL_NODE = -1;
+    static constexpr float AABB_MARGIN = 0.1f;
+    static constexpr float DISPLACEMENT_MULTIPLIER = 2.0f;
+
+    DynamicAABBTree() = default;
+
+    // Returns a proxy id that stays valid until destroy_proxy
+    int create_proxy(const AABB& aabb, uint32_t user_id);
+    void destroy_proxy(int proxy_id);
+
+    // Refit a proxy after its body moved; returns true if it was re-inserted
+    bool move_proxy(int proxy_id, const AABB& aabb, glm::vec3 displacement);
+
+    void clear();
+
+    uint32_t user_id(int proxy_id) const { return _nodes[proxy_id].user_id; }
+    const AABB& fat_aabb(int proxy_id) const { return _nodes[proxy_id].aabb; }
+    size_t proxy_count() const { return _proxy_count; }
+    int height() const { return _root == NULL_NODE ? 0 : _nodes[_root].height; }
+
+    // Visit every proxy whose fat AABB overlaps the box.
+    // callback(int proxy_id) -> bool, return false to stop.
+    template <typename Callback>
+    void query(const AABB& aabb, Callback&& callback) const;
+
+    // Batched query: one traversal for all boxes, carrying down to each node
+    // only the boxes that overlap it (scratch as for raycast_many). Each box
+    // sees its proxies in the same order as query() would give them.
+    // callback(int proxy_id, uint32_t box)
+    template <typename Callback>
+    void query_many(const AABB* aabbs, uint32_t box_count, std::vector<uint32_t>& scratch,
+                    Callback&& callback) const;
+
+    // Visit every proxy whose fat AABB the ray enters within max_dist.
+    // callback(int proxy_id, float max_dist) -> float, returns the new max
+    // distance (clip to the closest hit so far, 0 to stop).
+    template <typename Callback>
+    void raycast(glm::vec3 origin, glm::vec3 direction, float max_dist, Callback&& callback) const;
+
+    // Batched raycast: one traversal for all rays, carrying down to each node
+    // only the rays that enter it. max_dists is per ray and clipped in place;
+    // scratch holds the per-node ray lists (reuse it to avoid allocations).
+    // callback(int proxy_id, uint32_t ray, float max_dist) -> float, as above.
+    template <typename Callback>
+    void raycast_many(const glm::vec3* origins, const glm::vec3* inv_directions, float* max_dists,
+                      uint32_t ray_count, std::vector<uint32_t>& scratch, Callback&& callback) const;
+
+private:
+    struct Node {
+        AABB aabb;
+        uint32_t user_id = 0;
+        int parent = NULL_NODE;    // Next free node when on the free list
+        int child1 = NULL_NODE;
+        int child2 = NULL_NODE;
+        int height = -1;           // Leaf = 0, free node = -1
+
+        bool is_leaf() const { return child1 == NULL_NODE; }
+    };
+
+    // Traversal stack kept on the C++ stack for typical depths, so queries
+    // stay allocation-free and safe to run from several threads
+    class NodeStack {
+    public:
+        void push(int node) {
+            if (_size < FIXED_CAPACITY) {
+                _fixed[_size++] = node;
+            } else {
+                _overflow.push_back(node);
+                ++_size;
+            }
+        }
+        int pop() {
+            --_size;
+            if (_size >= FIXED_CAPACITY) {
+                int node = _overflow.back();
+                _overflow.pop_back();
+                return node;
+            }
+            return _fixed[_size];
+        }
+        bool empty() const { return _size == 0; }
+
+    private:
+        static constexpr int FIXED_CAPACITY = 128;
+        int _fixed[FIXED_CAPACITY];
+        int _size = 0;
+        std::vector<int> _overflow;
+    };
+
+    int allocate_node();
+    void free_node(int node);
+    void insert_leaf(int leaf);
+    void remove_leaf(int leaf);
+    int balance(int node);
+
+    std::vector<Node> _nodes;
+    int _root = NULL_NODE;
+    int _free_list = NULL_NODE;
+    size_t _proxy_count = 0;
+};
+
+template <typename Callback>
+void DynamicAABBTree::query(const AABB& aabb, Callback&& callback) const {
+    NodeStack stack;
+    stack.push(_root);
+
+    while (!stack.empty()) {
+        int id = stack.pop();
+        if (id == NULL_NODE) continue;
+
+        const Node& node = _nodes[id];
+        if (!node.aabb.overlaps(aabb)) continue;
+
+        if (node.is_leaf()) {
+            if (!callback(id)) return;
+        } else {
+            stack.push(node.child1);
+            stack.push(node.child2);
+        }
+    }
+}
+
+template <typename Callback>
+void DynamicAABBTree::query_many(const AABB* aabbs, uint32_t box_count, std::vector<uint32_t>& scratch,
+                                 Callback&& callback) const {
+    scratch.clear();
+    for (uint32_t box = 0; box < box_count; ++box) {
+        scratch.push_back(box);
+    }
+
+    // Same (first box, box count, node) stack entries as raycast_many
+    NodeStack stack;
+    stack.push(0);
+    stack.push(static_cast<int>(box_count));
+    stack.push(_root);
+
+    while (!stack.empty()) {
+        int id = stack.pop();
+        uint32_t count = static_cast<uint32_t>(stack.pop());
+        uint32_t begin = static_cast<uint32_t>(stack.pop());
+        if (id == NULL_NODE) continue;
+
+        scratch.resize(begin + count);
+
+        const Node& node = _nodes[id];
+        uint32_t list_begin = static_cast<uint32_t>(scratch.size());
+        for (uint32_t i = begin; i < begin + count; ++i) {
+            uint32_t box = scratch[i];
+            if (node.aabb.overlaps(aabbs[box])) {
+                scratch.push_back(box);
+            }
+        }
+
+        uint32_t list_count = static_cast<uint32_t>(scratch.size()) - list_begin;
+        if (list_count == 0) continue;
+
+        if (node.is_leaf()) {
+            for (uint32_t i = list_begin; i < list_begin + list_count; ++i) {
+                callback(id, scratch[i]);
+            }
+        } else {
+            stack.push(static_cast<int>(list_begin));
+            stack.push(static_cast<int>(list_count));
+            stack.push(node.child1);
+            stack.push(static_cast<int>(list_begin));
+            stack.push(static_cast<int>(list_count));
+            stack.push(node.child2);
+        }
+    }
+}
+
+template <typename Callback>
+void DynamicAABBTree::raycast(glm::vec3 origin, glm::vec3 direction, float max_dist,
+                              Callback&& callback) const {
+    glm::vec3 inv_direction = 1.0f / direction;
+
+    NodeStack stack;
+    stack.push(_root);
+
+    while (!stack.empty()) {
+        int id = stack.pop();
+        if (id == NULL_NODE) continue;
+
+        const Node& node = _nodes[id];
+        if (!node.aabb.intersects_ray(origin, inv_direction, max_dist)) continue;
+
+        if (node.is_leaf()) {
+            float new_max = callback(id, max_dist);
+            if (new_max <= 0.0f) return;
+            max_dist = new_max;
+        } else {
+            stack.push(node.child1);
+            stack.push(node.child2);
+        }
+    }
+}
+
+template <typename Callback>
+void DynamicAABBTree::raycast_many(const glm::vec3* origins, const glm::vec3* inv_directions,
+                                   float* max_dists, uint32_t ray_count,
+                                   std::vector<uint32_t>& scratch, Callback&& callback) const {
+    scratch.clear();
+    for (uint32_t ray = 0; ray < ray_count; ++ray) {
+        scratch.push_back(ray);
+    }
+
+    // Entries are (node, first ray, ray count) into scratch. A node's list is
+    // appended after its parent's, and everything past the parent's list
+    // belongs to subtrees already finished when the node is popped (LIFO).
+    NodeStack stack;
+    stack.push(0);
+    stack.push(static_cast<int>(ray_count));
+    stack.push(_root);
+
+    while (!stack.empty()) {
+        int id = stack.pop();
+        uint32_t count = static_cast<uint32_t>(stack.pop());
+        uint32_t begin = static_cast<uint32_t>(stack.pop());
+        if (id == NULL_NODE) continue;
+
+        scratch.resize(begin + count);
+
+        const Node& node = _nodes[id];
+        uint32_t list_begin = static_cast<uint32_t>(scratch.size());
+        for (uint32_t i = begin; i < begin + count; ++i) {
+            uint32_t ray = scratch[i];
+            if (max_dists[ray] > 0.0f &&
+                node.aabb.intersects_ray(origins[ray], inv_directions[ray], max_dists[ray])) {
+                scratch.push_back(ray);
+            }
+        }
+
+        uint32_t list_count = static_cast<uint32_t>(scratch.size()) - list_begin;
+        if (list_count == 0) continue;
+
+        if (node.is_leaf()) {
+            for (uint32_t i = list_begin; i < list_begin + list_count; ++i) {
+                uint32_t ray = scratch[i];
+                max_dists[ray] = callback(id, ray, max_dists[ray]);
+            }
+        } else {
+            stack.push(static_cast<int>(list_begin));
+            stack.push(static_cast<int>(list_count));
+            stack.push(node.child1);
+            stack.push(static_cast<int>(list_begin));
+            stack.push(static_cast<int>(list_count));
+            stack.push(node.child2);
+        }
+    }
+}
+
+}  // namespace engine::physics
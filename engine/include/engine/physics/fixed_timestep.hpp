@@ -0,0 +1,55 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+
+namespace engine::physics {
+
+// Accumulator that turns variable frame times into a whole number of fixed
+// simulation steps. Time beyond max_substeps is dropped so a long hitch
+// slows the simulation down instead of spiralling; the leftover fraction is
+// exposed as an interpolation factor for rendering.
+class FixedTimestep {
+public:
+    static constexpr float DEFAULT_STEP = 1.0f / 60.0f;
+    static constexpr int DEFAULT_MAX_SUBSTEPS = 5;
+
+    explicit FixedTimestep(float step = DEFAULT_STEP, int max_substeps = DEFAULT_MAX_SUBSTEPS)
+        : _step(step), _max_substeps(max_substeps) {}
+
+    // Add a frame's worth of time and return how many steps to run now
+    int advance(float frame_delta) {
+        _accumulator += std::max(frame_delta, 0.0f);
+
+        int steps = 0;
+        while (_accumulator >= _step && steps < _max_substeps) {
+            _accumulator -= _step;
+            ++steps;
+        }
+
+        // Drop whatever the substep cap didn't allow for
+        if (_accumulator >= _step) {
+            _accumulator = std::fmod(_accumulator, _step);
+        }
+        return steps;
+    }
+
+    // Fraction of a step left in the accumulator, in [0, 1): blend factor
+    // between the previous and current simulated states
+    float alpha() const { return _accumulator / _step; }
+
+    float step() const { return _step; }
+    void set_step(float step) { _step = std::max(step, 1e-4f); }
+
+    int max_substeps() const { return _max_substeps; }
+    void set_max_substeps(int max_substeps) { _max_substeps = std::max(max_substeps, 1); }
+
+    void reset() { _accumulator = 0.0f; }
+
+private:
+    float _step;
+    int _max_substeps;
+    float _accumulator = 0.0f;
+};
+
+}  // namespace engine::physics
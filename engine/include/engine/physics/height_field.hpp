@@ -0,0 +1,77 @@
+#pragma once
+
+#include <engine/physics/aabb.hpp>
+#include <engine/physics/static_bvh.hpp>
+#include <engine/physics/triangle_mesh.hpp>
+
+#include <glm/glm.hpp>
+
+#include <cstdint>
+#include <vector>
+
+namespace engine::physics {
+
+// Static terrain: a grid of height samples, columns along X and rows along
+// Z, spaced cell_size apart with sample (0, 0) at the local origin. Each cell
+// is two triangles facing +Y. The BVH is built over cells, so a body only
+// tests the few cells under it. Shapes reference the field by pointer, so it
+// must outlive every body using it.
+class HeightField {
+public:
+    HeightField() = default;
+
+    // heights[row * columns + column]; needs at least 2x2 samples
+    HeightField(uint32_t columns, uint32_t rows, float cell_size, std::vector<float> heights);
+
+    uint32_t columns() const { return _columns; }
+    uint32_t rows() const { return _rows; }
+    float cell_size() const { return _cell_size; }
+    size_t cell_count() const { return _columns < 2 || _rows < 2 ? 0 : size_t(_columns - 1) * (_rows - 1); }
+
+    float height(uint32_t column, uint32_t row) const { return _heights[row * _columns + column]; }
+
+    // Surface height under a local-space XZ point (clamped to the grid)
+    float height_at(float x, float z) const;
+
+    // The two triangles of a cell (cell = row * (columns - 1) + column)
+    void cell_triangles(uint32_t cell, Triangle& first, Triangle& second) const;
+
+    // Local-space bounds of the whole field
+    AABB bounds() const { return _bvh.bounds(); }
+
+    // Visit every triangle of the cells whose bounds overlap a local-space box.
+    // callback(const Triangle&) -> bool, return false to stop.
+    template <typename Callback>
+    void query(const AABB& aabb, Callback&& callback) const {
+        _bvh.query(aabb, [&](uint32_t cell) {
+            Triangle first, second;
+            cell_triangles(cell, first, second);
+            return callback(first) && callback(second);
+        });
+    }
+
+    // Visit every triangle of the cells a local-space ray enters.
+    // callback(const Triangle&, float max_dist) -> float, as StaticBVH::raycast.
+    template <typename Callback>
+    void raycast(glm::vec3 origin, glm::vec3 direction, float max_dist, Callback&& callback) const {
+        _bvh.raycast(origin, direction, max_dist, [&](uint32_t cell, float dist) {
+            Triangle first, second;
+            cell_triangles(cell, first, second);
+            dist = callback(first, dist);
+            return dist > 0.0f ? callback(second, dist) : dist;
+        });
+    }
+
+private:
+    glm::vec3 sample(uint32_t column, uint32_t row) const {
+        return glm::vec3(column * _cell_size, height(column, row), row * _cell_size);
+    }
+
+    uint32_t _columns = 0;
+    uint32_t _rows = 0;
+    float _cell_size = 1.0f;
+    std::vector<float> _heights;
+    StaticBVH _bvh;
+};
+
+}  // namespace engine::physics
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <cstdint>
+#include <cstdio>
+
+// Build with ENGINE_PHYSICS_PROFILING=0 (CMake: GAME_PHYSICS_PROFILING=OFF)
+// to compile the profiler out of PhysicsWorld entirely
+#ifndef ENGINE_PHYSICS_PROFILING
+#define ENGINE_PHYSICS_PROFILING 1
+#endif
+
+namespace engine::physics {
+
+// Phases of a physics step, in the order they run
+enum class PhysicsPhase : uint8_t {
+    Integrate,     // Forces, gravity and drag into velocities and positions
+    BroadPhase,    // Proxy refit and candidate pairs
+    NarrowPhase,   // Shape tests, contact and trigger events, collision callback
+    Solve,         // Islands, velocity iterations, position correction, contact cache
+    QueryTree,     // Refit of the query tree
+    Sleep          // Rest timers and islands going to sleep
+};
+
+constexpr int PHYSICS_PHASE_COUNT = 6;
+
+const char* phase_name(PhysicsPhase phase);
+
+// What the last PhysicsWorld::update() or step() call spent its time on.
+// Times and pair counters are summed over the steps the call ran; body counts
+// are taken after its last step.
+struct PhysicsStats {
+    int steps = 0;
+    double phase_ms[PHYSICS_PHASE_COUNT] = {};
+    double total_ms = 0.0;
+
+    uint64_t candidate_pairs = 0;   // Pairs out of the broad phase
+    uint64_t touching_pairs = 0;    // Candidates whose shapes overlap (contacts and trigger overlaps)
+    uint64_t contacts = 0;          // Touching pairs handed to the solver
+    uint64_t islands = 0;           // Independently solved groups of contacts
+
+    uint32_t body_count = 0;
+    uint32_t static_body_count = 0;
+    uint32_t sleeping_body_count = 0;
+
+    double time(PhysicsPhase phase) const { return phase_ms[static_cast<int>(phase)]; }
+
+    // Share of broad phase candidates that really touch (how tight the broad phase is)
+    double hit_ratio() const {
+        return candidate_pairs > 0 ? static_cast<double>(touching_pairs) / candidate_pairs : 0.0;
+    }
+};
+
+// CSV dump for offline tuning: one header line, then one line per sample.
+// Phase times are per step (averaged over the call's steps), pair counters
+// are the call's totals.
+void write_stats_csv_header(std::FILE* file);
+void write_stats_csv_row(std::FILE* file, const PhysicsStats& stats);
+
+}  // namespace engine::physics
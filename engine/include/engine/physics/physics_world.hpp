@@ -1,18 +1,43 @@
 #pragma once
 
 #include <engine/physics/rigid_body.hpp>
+#include <engine/physics/body_store.hpp>
 #include <engine/physics/collision.hpp>
+#include <engine/physics/broad_phase.hpp>
+#include <engine/physics/contact_cache.hpp>
+#include <engine/physics/dynamic_aabb_tree.hpp>
+#include <engine/physics/fixed_timestep.hpp>
+#include <engine/physics/physics_stats.hpp>
+#include <engine/physics/task_pool.hpp>
 
 #include <glm/glm.hpp>
 
 #include <vector>
 #include <functional>
+#include <memory>
 
 namespace engine::physics {
 
 // Collision callback signature
 using CollisionCallback = std::function<void(RigidBody* a, RigidBody* b, const CollisionResult& result)>;
 
+// Optional per-body predicate for queries (return false to skip a body)
+using BodyFilter = std::function<bool(const RigidBody* body)>;
+
+struct SweepHit {
+    RigidBody* body = nullptr;
+    float time = 0.0f;            // Fraction of the motion at first contact
+    glm::vec3 point{0.0f};
+    glm::vec3 normal{0.0f};
+};
+
+struct Ray {
+    glm::vec3 origin{0.0f};
+    glm::vec3 direction{0.0f, 0.0f, -1.0f};  // Normalized by the query
+    float max_dist = 0.0f;
+    uint32_t mask = ALL_COLLISION_LAYERS;
+};
+
 struct RaycastHit {
     RigidBody* body = nullptr;
     float distance = 0.0f;
@@ -20,39 +45,350 @@ struct RaycastHit {
     glm::vec3 normal{0.0f};
 };
 
+// Touching pair without a trigger, recorded by the narrow phase
+struct ContactEvent {
+    BodyHandle a;
+    BodyHandle b;
+    glm::vec3 normal{0.0f};       // Direction to separate a from b
+    float penetration = 0.0f;
+    glm::vec3 point{0.0f};
+};
+
+enum class TriggerEventType {
+    Enter,    // Started overlapping this step
+    Exit      // Stopped overlapping (or one of the bodies was removed)
+};
+
+// Overlap of a trigger body with another body. Handles rather than pointers,
+// so events stay safe while game objects move or die before they are read;
+// PhysicsWorld::body() resolves them (null once a body has been removed).
+struct TriggerEvent {
+    TriggerEventType type = TriggerEventType::Enter;
+    BodyHandle trigger;
+    BodyHandle other;             // May be a trigger too
+};
+
+struct TriggerOverlap {
+    uint64_t key = 0;             // ContactCache::make_key of the two slots
+    BodyHandle trigger;
+    BodyHandle other;
+};
+
 class PhysicsWorld {
 public:
+    static constexpr int DEFAULT_SOLVER_ITERATIONS = 4;
+    static constexpr float SLEEP_LINEAR_VELOCITY = 0.05f;  // Below this a body counts as resting
+    static constexpr float TIME_TO_SLEEP = 0.5f;            // Seconds an island must rest
+
     PhysicsWorld();
-    ~PhysicsWorld() = default;
+    ~PhysicsWorld();
+
+    PhysicsWorld(const PhysicsWorld&) = delete;
+    PhysicsWorld& operator=(const PhysicsWorld&) = delete;
 
-    // Main update (call once per frame)
+    // Single variable-length step
     void update(float delta);
 
+    // Fixed-step mode (call once per frame with the frame time): runs as many
+    // fixed steps as the accumulated time allows, up to the substep cap, and
+    // returns how many ran. Positions from before the last step are kept so
+    // interpolated_position() can blend between the two for rendering.
+    int step(float frame_delta);
+    void set_fixed_timestep(float step, int max_substeps = FixedTimestep::DEFAULT_MAX_SUBSTEPS);
+    const FixedTimestep& fixed_timestep() const { return _timestep; }
+
+    // Blend factor between previous and current positions (1 after update())
+    float interpolation_alpha() const { return _interpolation_alpha; }
+    glm::vec3 interpolated_position(uint32_t index) const;
+
     // Gravity
     void set_gravity(glm::vec3 gravity);
     glm::vec3 gravity() const { return _gravity; }
 
-    // Body management
+    // Body management (bodies stay owned by the caller; removing or
+    // destroying a body copies its state back into the RigidBody)
     void add_body(RigidBody* body);
     void remove_body(RigidBody* body);
     void clear_bodies();
+    size_t body_count() const { return _store.size(); }
+
+    // Read-only access to the SoA body columns
+    const BodyStore& body_store() const { return _store; }
+
+    // Queries (accelerated by a dynamic AABB tree refit at the end of each update
+    // and whenever a body is moved by hand or changes shape).
+    // Only bodies whose collision layer intersects the mask are considered.
+    std::vector<RigidBody*> query_sphere(glm::vec3 center, float radius,
+                                         uint32_t mask = ALL_COLLISION_LAYERS);
+    std::vector<RigidBody*> query_aabb(glm::vec3 min, glm::vec3 max,
+                                       uint32_t mask = ALL_COLLISION_LAYERS);
+    bool raycast(glm::vec3 origin, glm::vec3 direction, float max_dist, RaycastHit& hit,
+                 uint32_t mask = ALL_COLLISION_LAYERS);
 
-    // Queries
-    std::vector<RigidBody*> query_sphere(glm::vec3 center, float radius);
-    std::vector<RigidBody*> query_aabb(glm::vec3 min, glm::vec3 max);
-    bool raycast(glm::vec3 origin, glm::vec3 direction, float max_dist, RaycastHit& hit);
+    // Allocation-free forms for queries run every frame: results go into a
+    // caller-owned vector (cleared, its capacity kept) or to a visitor
+    // bool(RigidBody*) that returns false to stop early. Both return the
+    // number of bodies found.
+    size_t query_sphere(glm::vec3 center, float radius, std::vector<RigidBody*>& results,
+                        uint32_t mask = ALL_COLLISION_LAYERS) const;
+    size_t query_aabb(glm::vec3 min, glm::vec3 max, std::vector<RigidBody*>& results,
+                      uint32_t mask = ALL_COLLISION_LAYERS) const;
+    template <typename Visitor>
+    size_t visit_sphere(glm::vec3 center, float radius, Visitor&& visitor,
+                        uint32_t mask = ALL_COLLISION_LAYERS) const;
+    template <typename Visitor>
+    size_t visit_aabb(glm::vec3 min, glm::vec3 max, Visitor&& visitor,
+                      uint32_t mask = ALL_COLLISION_LAYERS) const;
 
-    // Collision callback (called for each collision)
+    // Broad query only: body_store() indices of the bodies whose query tree
+    // bounds overlap the box, with no shape test. For systems that run their
+    // own exact tests against the store columns (character controllers).
+    size_t query_candidates(const AABB& bounds, std::vector<uint32_t>& indices,
+                            uint32_t mask = ALL_COLLISION_LAYERS) const;
+
+    // Batched query_candidates: all boxes share a single traversal, each with
+    // its own mask. Box i's indices are indices[offsets[i]] up to
+    // indices[offsets[i + 1]], in the order query_candidates gives them.
+    void query_candidates_many(const AABB* bounds, const uint32_t* masks, uint32_t count,
+                               std::vector<uint32_t>& offsets, std::vector<uint32_t>& indices);
+
+    // Batched raycast (aim and line-of-sight checks): all rays share a single
+    // traversal of the query tree, each with its own mask. hits is resized to match rays, a ray that
+    // hits nothing leaves a null body; returns the number of rays that hit.
+    size_t raycast_many(const std::vector<Ray>& rays, std::vector<RaycastHit>& hits);
+
+    // Time of impact: earliest contact of a sphere moving from start to
+    // start + motion against the bodies at their current positions. Used for
+    // fast movers that would otherwise skip through thin or small bodies.
+    bool sweep_sphere(glm::vec3 start, float radius, glm::vec3 motion, SweepHit& hit,
+                      uint32_t mask = ALL_COLLISION_LAYERS, const BodyFilter& filter = nullptr);
+
+    // Contact events: every touching pair without a trigger found by the last
+    // update() or step() call (all of its fixed steps, in step then pair
+    // order), before resolution. The buffer is reused from call to call, so
+    // game systems can read it after stepping without any allocation.
+    const std::vector<ContactEvent>& contact_events() const { return _contact_events; }
+
+    // Collision callback: adapter over the contact events, called on the
+    // calling thread for each event of a step once its narrow phase is done
     void set_collision_callback(CollisionCallback callback);
 
+    // Trigger volumes: overlaps involving a trigger body are kept across steps
+    // and reported as Enter/Exit events, which accumulate over every step of a
+    // frame in one buffer until the caller drains it with clear_trigger_events().
+    // Overlaps that are still going on ("stay") are in trigger_overlaps().
+    const std::vector<TriggerEvent>& trigger_events() const { return _trigger_events; }
+    void clear_trigger_events() { _trigger_events.clear(); }
+    const std::vector<TriggerOverlap>& trigger_overlaps() const { return _trigger_overlaps; }
+
+    // Body for a handle, or null if it has been removed
+    RigidBody* body(BodyHandle handle) const;
+
+    // Broad phase (spatial hash by default)
+    void set_broad_phase(BroadPhaseType type);
+    void set_broad_phase(std::unique_ptr<BroadPhase> broad_phase);
+    BroadPhase& broad_phase() { return *_broad_phase; }
+
+    // Deterministic mode: pairs are processed in body order (same order as the
+    // brute-force loop), independent of the broad phase implementation. With
+    // the same build and the same inputs, stepping is then bit-identical across
+    // runs and thread counts (the parallel path always sorts pairs, and solving
+    // island by island matches the single-island serial solve). Build with
+    // GAME_STRICT_FP to also rule out FMA contraction differences.
+    void set_deterministic(bool deterministic) { _deterministic = deterministic; }
+    bool is_deterministic() const { return _deterministic; }
+
+    // Hash of every body's slot, position and velocity bit patterns (in body
+    // order). Comparing it frame by frame checks that two runs stay identical.
+    uint64_t state_hash() const;
+
+    // Contact solver: every contact of a step is generated first, then the
+    // velocity impulses are solved with the given number of sequential impulse
+    // iterations (more = stiffer stacks and crowds), then penetration is
+    // corrected. With warm starting each pair starts from the impulse it ended
+    // the previous step with (looked up in a cache keyed by the body pair), so
+    // resting contacts settle within a few steps instead of re-converging.
+    void set_solver_iterations(int iterations);
+    int solver_iterations() const { return _solver_iterations; }
+    void set_warm_starting(bool warm_starting) { _warm_starting = warm_starting; }
+    bool is_warm_starting() const { return _warm_starting; }
+    const ContactCache& contact_cache() const { return _contact_cache; }
+
+    // Sleeping: islands of dynamic bodies (connected by touching contacts)
+    // that all stay below SLEEP_LINEAR_VELOCITY for TIME_TO_SLEEP go to sleep
+    // together. Sleeping bodies aren't integrated or refit, and pairs between
+    // sleeping and static bodies are never generated. A body wakes when an
+    // awake dynamic body touches it, on a force or impulse, when it is moved
+    // by hand, when a body it could rest on is removed, or through wake().
+    void set_sleeping_enabled(bool enabled);
+    bool is_sleeping_enabled() const { return _sleeping_enabled; }
+    size_t sleeping_body_count() const { return _sleeping_count; }
+    void wake_all();
+
+    // Parallel stepping: with more than one thread the narrow phase is split
+    // across workers and contacts are solved per island (bodies connected by
+    // touching pairs; static bodies don't join islands). Events are still
+    // recorded, and the callback run, in body pair order. 1 = serial (default).
+    void set_thread_count(unsigned count);
+    unsigned thread_count() const { return _task_pool ? _task_pool->thread_count() : 1; }
+
+    // Profiling: wall time per phase plus pair and body counters, kept for the
+    // last update() or step() call that ran a step. Off by default; while off
+    // each phase costs one branch, and building with ENGINE_PHYSICS_PROFILING=0
+    // removes even that.
+    void set_profiling_enabled(bool enabled);
+    bool is_profiling_enabled() const { return ENGINE_PHYSICS_PROFILING && _profiling; }
+    const PhysicsStats& stats() const { return _stats; }
+
 private:
+    friend class RigidBody;
+
+    // Called by RigidBody when it is moved in memory or its shape changes
+    void rebind_body(RigidBody* body);
+    void on_shape_changed(RigidBody* body);
+    void on_position_changed(RigidBody* body);
+    void wake_body(uint32_t index);
+    void begin_stats();
+    void end_step_stats();
+    double* phase_time(PhysicsPhase phase) {
+        return is_profiling_enabled() ? &_stats.phase_ms[static_cast<int>(phase)] : nullptr;
+    }
+
+    void simulate(float delta);
     void integrate(float delta);
     void detect_and_resolve_collisions();
-    void resolve_collision(RigidBody* a, RigidBody* b, const CollisionResult& result);
+    void detect_and_resolve_parallel();
+    void union_contact_islands();
+    void build_islands();
+    uint32_t find_island_root(uint32_t index);
+    void solve_island(size_t island);
+    void store_contacts();
+    void begin_narrow_phase();
+    void add_narrow_result(const BodyPair& pair, const CollisionResult& result);
+    void end_narrow_phase();
+    void add_trigger_overlap(uint32_t a, uint32_t b);
+    void update_triggers();
+    void wake_touched(uint32_t a, uint32_t b);
+    void update_sleep(float delta);
+    void update_proxies();
+    void update_query_tree(float delta);
+    bool raycast_body(uint32_t index, glm::vec3 origin, glm::vec3 direction,
+                      float max_dist, uint32_t mask, RaycastHit& hit) const;
+    template <typename Visitor>
+    size_t visit_overlaps(const CollisionShape& shape, glm::vec3 center, const AABB& bounds,
+                          uint32_t mask, Visitor& visitor) const;
 
-    std::vector<RigidBody*> _bodies;
+    BodyStore _store;
     glm::vec3 _gravity{0.0f, -9.81f, 0.0f};
     CollisionCallback _collision_callback;
+
+    // Fixed-step mode
+    FixedTimestep _timestep;
+    float _interpolation_alpha = 1.0f;
+
+    // Broad phase state (proxies are indexed like the body store)
+    std::unique_ptr<BroadPhase> _broad_phase;
+    std::vector<BroadPhaseProxy> _proxies;
+    std::vector<BodyPair> _pairs;
+    bool _proxies_dirty = true;    // Body set changed: refit sleeping proxies too
+    bool _deterministic = false;
+
+    // Query acceleration (proxy user id = body store slot)
+    DynamicAABBTree _query_tree;
+
+    // Batched raycast scratch (reused every call)
+    std::vector<glm::vec3> _ray_origins;
+    std::vector<glm::vec3> _ray_directions;
+    std::vector<glm::vec3> _ray_inv_directions;
+    std::vector<float> _ray_max_dists;
+    std::vector<uint32_t> _ray_masks;
+    std::vector<uint32_t> _ray_lists;
+
+    // Batched candidate query scratch (box lists, then hits in tree order)
+    std::vector<uint32_t> _box_lists;
+    std::vector<uint32_t> _candidate_boxes;
+    std::vector<uint32_t> _candidate_hits;
+
+    // Contact solver state (reused every step)
+    struct Contact {
+        uint32_t a;
+        uint32_t b;
+        CollisionResult result;
+        float normal_mass = 0.0f;      // 1 / (inv_mass_a + inv_mass_b), 0 if both static
+        float target_velocity = 0.0f;  // Separating speed wanted along the normal (restitution)
+        float normal_impulse = 0.0f;   // Accumulated over the iterations (>= 0)
+    };
+
+    void prepare_contact(Contact& contact);
+    void apply_contact_impulse(const Contact& contact, float impulse);
+    void solve_contact_velocity(Contact& contact);
+    void correct_contact_position(const Contact& contact);
+
+    int _solver_iterations = DEFAULT_SOLVER_ITERATIONS;
+    bool _warm_starting = true;
+    ContactCache _contact_cache;
+    std::vector<Contact> _contacts;                // Touching non-trigger pairs, in pair order
+
+    // Contact events of the current update()/step() call
+    std::vector<ContactEvent> _contact_events;
+    size_t _step_events_begin = 0;                 // First event of the running step
+
+    // Trigger state (overlaps sorted by key)
+    std::vector<TriggerOverlap> _trigger_overlaps;
+    std::vector<TriggerOverlap> _new_trigger_overlaps;
+    std::vector<TriggerEvent> _trigger_events;
+
+    // Sleep state
+    bool _sleeping_enabled = true;
+    size_t _sleeping_count = 0;
+    std::vector<float> _island_sleep_time;         // Island root -> shortest rest time
+
+    // Parallel stepping state (reused every step)
+    std::unique_ptr<TaskPool> _task_pool;
+    std::vector<CollisionResult> _narrow_results;  // Indexed like _pairs
+    std::vector<uint32_t> _island_parent;          // Union-find over body indices
+    std::vector<uint32_t> _island_ids;             // Root body -> island id
+    std::vector<uint32_t> _contact_islands;        // Contact -> island id
+    std::vector<uint32_t> _island_start;           // Island -> first entry in _island_contacts
+    std::vector<uint32_t> _island_contacts;        // Contact indices grouped by island
+
+    // Profiler
+    bool _profiling = false;
+    PhysicsStats _stats;
 };
 
+template <typename Visitor>
+size_t PhysicsWorld::visit_sphere(glm::vec3 center, float radius, Visitor&& visitor,
+                                  uint32_t mask) const {
+    AABB bounds(center - glm::vec3(radius), center + glm::vec3(radius));
+    return visit_overlaps(SphereShape(radius), center, bounds, mask, visitor);
+}
+
+template <typename Visitor>
+size_t PhysicsWorld::visit_aabb(glm::vec3 min, glm::vec3 max, Visitor&& visitor,
+                                uint32_t mask) const {
+    glm::vec3 center = (min + max) * 0.5f;
+    glm::vec3 half_extents = (max - min) * 0.5f;
+    return visit_overlaps(AABBShape(half_extents), center, AABB(min, max), mask, visitor);
+}
+
+template <typename Visitor>
+size_t PhysicsWorld::visit_overlaps(const CollisionShape& shape, glm::vec3 center,
+                                    const AABB& bounds, uint32_t mask, Visitor& visitor) const {
+    size_t count = 0;
+
+    _query_tree.query(bounds, [&](int proxy) {
+        uint32_t index = _store.dense_index_of_slot(_query_tree.user_id(proxy));
+        if ((_store.collision_layers[index] & mask) == 0) return true;
+
+        auto result = test_collision(shape, center, _store.shapes[index], _store.position(index));
+        if (!result.collided) return true;
+
+        ++count;
+        return static_cast<bool>(visitor(_store.owners[index]));
+    });
+
+    return count;
+}
+
 }  // namespace engine::physics
@@ -1,23 +1,27 @@
 #pragma once
 
+#include <engine/physics/body_store.hpp>
 #include <engine/physics/collision_shape.hpp>
 
 #include <glm/glm.hpp>
 
-#include <memory>
-
 namespace engine::physics {
 
+class PhysicsWorld;
+
+// Handle facade over a body. While registered with a PhysicsWorld the
+// simulation state lives in the world's BodyStore (SoA columns); while
+// detached it is kept locally and copied in on add_body.
 class RigidBody {
 public:
     RigidBody() = default;
-    ~RigidBody() = default;
+    ~RigidBody();
 
-    // Disable copy, allow move
+    // Disable copy, allow move (a moved body keeps its place in the world)
     RigidBody(const RigidBody&) = delete;
     RigidBody& operator=(const RigidBody&) = delete;
-    RigidBody(RigidBody&&) = default;
-    RigidBody& operator=(RigidBody&&) = default;
+    RigidBody(RigidBody&& other) noexcept;
+    RigidBody& operator=(RigidBody&& other) noexcept;
 
     // Apply a force (accumulated over frame, affected by mass)
     void apply_force(glm::vec3 force);
@@ -25,12 +29,9 @@ public:
     // Apply an impulse (immediate velocity change)
     void apply_impulse(glm::vec3 impulse);
 
-    // Clear accumulated forces (called after integration)
+    // Clear accumulated forces (done by PhysicsWorld after integration)
     void clear_forces();
 
-    // Integrate motion (called by PhysicsWorld)
-    void integrate(float delta, glm::vec3 gravity);
-
     // Position with shape offset applied
     glm::vec3 world_position() const;
 
@@ -38,30 +39,76 @@ public:
     void set_sphere(float radius);
     void set_aabb(glm::vec3 half_extents);
     void set_capsule(float radius, float height);
+    // World geometry: also makes the body static (the geometry must outlive it)
+    void set_mesh(const TriangleMesh* mesh);
+    void set_height_field(const HeightField* field);
+    void set_shape(const CollisionShape& shape);
+    // Null while the body has no shape (points into the world's shape column
+    // while attached, so don't keep it across add/remove)
+    const CollisionShape* shape() const;
 
     // Transform
-    glm::vec3 position{0.0f};
-    glm::vec3 velocity{0.0f};
+    glm::vec3 position() const;
+    void set_position(glm::vec3 position);
+    // Position blended between the last two fixed steps of the world
+    // (equal to position() when detached or when stepping with update())
+    glm::vec3 interpolated_position() const;
+    glm::vec3 velocity() const;
+    void set_velocity(glm::vec3 velocity);
 
     // Physics properties
-    float mass = 1.0f;
-    float inv_mass = 1.0f;        // Inverse mass (0 for static objects)
-    float drag = 0.1f;            // Linear drag coefficient
-    float restitution = 0.0f;     // Bounciness (0 = no bounce, 1 = perfect bounce)
+    float mass() const;
+    void set_mass(float mass);                 // Also updates inverse mass
+    float inv_mass() const;                    // 0 for static bodies
+    float drag() const;
+    void set_drag(float drag);                 // Linear drag coefficient
+    float restitution() const;
+    void set_restitution(float restitution);   // Bounciness (0 = no bounce, 1 = perfect bounce)
 
     // Flags
-    bool use_gravity = true;
-    bool is_static = false;       // Static bodies don't move
-    bool is_trigger = false;      // Trigger bodies detect overlap but don't resolve
-
-    // Collision shape
-    std::unique_ptr<CollisionShape> shape;
+    bool use_gravity() const { return (flags() & BODY_USE_GRAVITY) != 0; }
+    void set_use_gravity(bool use_gravity);
+    bool is_static() const { return (flags() & BODY_STATIC) != 0; }
+    void set_static(bool is_static);           // Static bodies don't move
+    bool is_trigger() const { return (flags() & BODY_TRIGGER) != 0; }
+    void set_trigger(bool is_trigger);         // Trigger bodies detect overlap but don't resolve
+
+    // Collision filtering (see DEFAULT_COLLISION_LAYER): pairs need each
+    // body's layer in the other's mask; queries only see bodies on their mask
+    uint32_t collision_layer() const;
+    void set_collision_layer(uint32_t layer);
+    uint32_t collision_mask() const;
+    void set_collision_mask(uint32_t mask);
+
+    // Sleeping: a body that stays slow (together with everything it touches)
+    // is put to sleep by the world and skipped until a moving body touches it,
+    // it gets a force or impulse, it is moved by hand, or wake() is called
+    bool is_sleeping() const { return (flags() & BODY_SLEEPING) != 0; }
+    void wake();
+    bool can_sleep() const { return (flags() & BODY_NEVER_SLEEP) == 0; }
+    void set_can_sleep(bool can_sleep);
+
+    // World this body is registered with (null while detached)
+    PhysicsWorld* world() const { return _world; }
+    BodyHandle handle() const { return _handle; }
 
     // User data pointer for game objects
     void* user_data = nullptr;
 
 private:
-    glm::vec3 _accumulated_force{0.0f};
+    friend class PhysicsWorld;
+
+    uint32_t flags() const;
+    void set_flag(uint32_t flag, bool enabled);
+    void refresh_inv_mass();
+
+    // Store and dense index while attached
+    BodyStore& store() const;
+    uint32_t index() const;
+
+    PhysicsWorld* _world = nullptr;
+    BodyHandle _handle;
+    BodyState _local;                          // State while detached (shape included)
 };
 
 }  // namespace engine::physics
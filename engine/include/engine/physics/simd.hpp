@@ -0,0 +1,107 @@
+#pragma once
+
+// Minimal float vector wrapper so physics kernels are written once and compile
+// to AVX (8 lanes), SSE2 (4 lanes) or plain scalar code (1 lane). Only
+// IEEE add/sub/mul/div/min/max and ordered comparisons are used, so every
+// width gives bit-identical results to the scalar path. Comparisons return a
+// Mask; bits() packs it to one bit per lane (lane 0 in bit 0).
+
+#if defined(__AVX__)
+#include <immintrin.h>
+#define ENGINE_PHYSICS_SIMD_AVX 1
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define ENGINE_PHYSICS_SIMD_SSE 1
+#endif
+
+#include <algorithm>
+
+namespace engine::physics::simd {
+
+#if defined(ENGINE_PHYSICS_SIMD_AVX)
+
+constexpr int WIDTH = 8;
+
+struct Float {
+    __m256 v;
+};
+
+inline Float load(const float* p) { return {_mm256_loadu_ps(p)}; }
+inline void store(float* p, Float a) { _mm256_storeu_ps(p, a.v); }
+inline Float splat(float s) { return {_mm256_set1_ps(s)}; }
+
+inline Float operator+(Float a, Float b) { return {_mm256_add_ps(a.v, b.v)}; }
+inline Float operator-(Float a, Float b) { return {_mm256_sub_ps(a.v, b.v)}; }
+inline Float operator*(Float a, Float b) { return {_mm256_mul_ps(a.v, b.v)}; }
+inline Float operator/(Float a, Float b) { return {_mm256_div_ps(a.v, b.v)}; }
+inline Float min(Float a, Float b) { return {_mm256_min_ps(a.v, b.v)}; }
+inline Float max(Float a, Float b) { return {_mm256_max_ps(a.v, b.v)}; }
+
+struct Mask {
+    __m256 v;
+};
+
+inline Mask operator<(Float a, Float b) { return {_mm256_cmp_ps(a.v, b.v, _CMP_LT_OQ)}; }
+inline Mask operator<=(Float a, Float b) { return {_mm256_cmp_ps(a.v, b.v, _CMP_LE_OQ)}; }
+inline Mask operator&(Mask a, Mask b) { return {_mm256_and_ps(a.v, b.v)}; }
+inline int bits(Mask m) { return _mm256_movemask_ps(m.v); }
+
+#elif defined(ENGINE_PHYSICS_SIMD_SSE)
+
+constexpr int WIDTH = 4;
+
+struct Float {
+    __m128 v;
+};
+
+inline Float load(const float* p) { return {_mm_loadu_ps(p)}; }
+inline void store(float* p, Float a) { _mm_storeu_ps(p, a.v); }
+inline Float splat(float s) { return {_mm_set1_ps(s)}; }
+
+inline Float operator+(Float a, Float b) { return {_mm_add_ps(a.v, b.v)}; }
+inline Float operator-(Float a, Float b) { return {_mm_sub_ps(a.v, b.v)}; }
+inline Float operator*(Float a, Float b) { return {_mm_mul_ps(a.v, b.v)}; }
+inline Float operator/(Float a, Float b) { return {_mm_div_ps(a.v, b.v)}; }
+inline Float min(Float a, Float b) { return {_mm_min_ps(a.v, b.v)}; }
+inline Float max(Float a, Float b) { return {_mm_max_ps(a.v, b.v)}; }
+
+struct Mask {
+    __m128 v;
+};
+
+inline Mask operator<(Float a, Float b) { return {_mm_cmplt_ps(a.v, b.v)}; }
+inline Mask operator<=(Float a, Float b) { return {_mm_cmple_ps(a.v, b.v)}; }
+inline Mask operator&(Mask a, Mask b) { return {_mm_and_ps(a.v, b.v)}; }
+inline int bits(Mask m) { return _mm_movemask_ps(m.v); }
+
+#else
+
+constexpr int WIDTH = 1;
+
+struct Float {
+    float v;
+};
+
+inline Float load(const float* p) { return {*p}; }
+inline void store(float* p, Float a) { *p = a.v; }
+inline Float splat(float s) { return {s}; }
+
+inline Float operator+(Float a, Float b) { return {a.v + b.v}; }
+inline Float operator-(Float a, Float b) { return {a.v - b.v}; }
+inline Float operator*(Float a, Float b) { return {a.v * b.v}; }
+inline Float operator/(Float a, Float b) { return {a.v / b.v}; }
+inline Float min(Float a, Float b) { return {std::min(a.v, b.v)}; }
+inline Float max(Float a, Float b) { return {std::max(a.v, b.v)}; }
+
+struct Mask {
+    bool v;
+};
+
+inline Mask operator<(Float a, Float b) { return {a.v < b.v}; }
+inline Mask operator<=(Float a, Float b) { return {a.v <= b.v}; }
+inline Mask operator&(Mask a, Mask b) { return {a.v && b.v}; }
+inline int bits(Mask m) { return m.v ? 1 : 0; }
+
+#endif
+
+}  // namespace engine::physics::simd
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <engine/physics/broad_phase.hpp>
+
+#include <cstdint>
+#include <vector>
+
+namespace engine::physics {
+
+// Uniform grid broad phase. Each body is inserted into every cell its bounds
+// touch; cells are hashed into a bucket array that is rebuilt every step with
+// a counting sort, so steady-state updates do not allocate.
+class SpatialHashBroadPhase : public BroadPhase {
+public:
+    explicit SpatialHashBroadPhase(float cell_size = DEFAULT_CELL_SIZE);
+
+    BroadPhaseType type() const override { return BroadPhaseType::SpatialHash; }
+
+    void find_pairs(const std::vector<BroadPhaseProxy>& proxies,
+                    std::vector<BodyPair>& out_pairs) override;
+
+    // Cell edge length (should be around the size of a typical dynamic body)
+    void set_cell_size(float cell_size);
+    float cell_size() const { return _cell_size; }
+
+    static constexpr float DEFAULT_CELL_SIZE = 2.0f;
+
+    // Bodies spanning more cells than this (ground, walls) skip the grid and
+    // are tested against every other body instead
+    static constexpr int MAX_CELLS_PER_BODY = 64;
+
+private:
+    struct CellEntry {
+        uint64_t key;
+        uint32_t body;
+    };
+
+    glm::ivec3 cell_of(glm::vec3 point) const;
+    static uint64_t cell_key(glm::ivec3 cell);
+
+    float _cell_size;
+    float _inv_cell_size;
+
+    // Scratch buffers reused across steps
+    std::vector<CellEntry> _entries;
+    std::vector<CellEntry> _sorted;
+    std::vector<uint32_t> _bucket_start;
+    std::vector<uint32_t> _oversized;
+};
+
+}  // namespace engine::physics
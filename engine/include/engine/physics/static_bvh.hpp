@@ -0,0 +1,118 @@
+#pragma once
+
+#include <engine/physics/aabb.hpp>
+
+#include <glm/glm.hpp>
+
+#include <cstdint>
+#include <vector>
+
+namespace engine::physics {
+
+// Bounding volume hierarchy over a fixed set of primitives (the triangles of
+// a static mesh, the cells of a height field). Built once, top-down, by
+// splitting the longest axis at the median centroid, so the depth stays
+// logarithmic in the primitive count. Nodes are stored depth-first: a node's
+// first child is the next node.
+class StaticBVH {
+public:
+    static constexpr uint32_t MAX_LEAF_PRIMITIVES = 4;
+
+    StaticBVH() = default;
+
+    // primitive_bounds[i] are the bounds of primitive i
+    void build(const std::vector<AABB>& primitive_bounds);
+    void clear();
+
+    bool empty() const { return _nodes.empty(); }
+    AABB bounds() const { return empty() ? AABB() : _nodes[0].bounds; }
+    size_t node_count() const { return _nodes.size(); }
+
+    // Visit every primitive whose bounds overlap the box.
+    // callback(uint32_t primitive) -> bool, return false to stop.
+    template <typename Callback>
+    void query(const AABB& aabb, Callback&& callback) const;
+
+    // Visit every primitive whose bounds the ray enters within max_dist.
+    // callback(uint32_t primitive, float max_dist) -> float, returns the new
+    // max distance (clip to the closest hit so far, 0 to stop).
+    template <typename Callback>
+    void raycast(glm::vec3 origin, glm::vec3 direction, float max_dist, Callback&& callback) const;
+
+private:
+    struct Node {
+        AABB bounds;
+        uint32_t first = 0;          // Leaf: first entry in _primitives; inner: second child
+        uint32_t count = 0;          // Primitives in a leaf, 0 for inner nodes
+
+        bool is_leaf() const { return count > 0; }
+    };
+
+    // Traversal stack size: median splits halve the primitive count at every
+    // level, so the depth stays far below this
+    static constexpr int MAX_DEPTH = 64;
+
+    uint32_t build_node(const std::vector<AABB>& primitive_bounds,
+                        const std::vector<glm::vec3>& centroids, uint32_t begin, uint32_t end);
+
+    std::vector<Node> _nodes;
+    std::vector<uint32_t> _primitives;
+    std::vector<AABB> _leaf_bounds;  // Bounds of _primitives[i], tested inside leaves
+};
+
+template <typename Callback>
+void StaticBVH::query(const AABB& aabb, Callback&& callback) const {
+    if (_nodes.empty()) return;
+
+    uint32_t stack[MAX_DEPTH];
+    int size = 0;
+    stack[size++] = 0;
+
+    while (size > 0) {
+        const uint32_t id = stack[--size];
+        const Node& node = _nodes[id];
+        if (!node.bounds.overlaps(aabb)) continue;
+
+        if (node.is_leaf()) {
+            for (uint32_t i = node.first; i < node.first + node.count; ++i) {
+                if (!_leaf_bounds[i].overlaps(aabb)) continue;
+                if (!callback(_primitives[i])) return;
+            }
+        } else {
+            stack[size++] = node.first;
+            stack[size++] = id + 1;
+        }
+    }
+}
+
+template <typename Callback>
+void StaticBVH::raycast(glm::vec3 origin, glm::vec3 direction, float max_dist,
+                        Callback&& callback) const {
+    if (_nodes.empty()) return;
+
+    glm::vec3 inv_direction = 1.0f / direction;
+
+    uint32_t stack[MAX_DEPTH];
+    int size = 0;
+    stack[size++] = 0;
+
+    while (size > 0) {
+        const uint32_t id = stack[--size];
+        const Node& node = _nodes[id];
+        if (!node.bounds.intersects_ray(origin, inv_direction, max_dist)) continue;
+
+        if (node.is_leaf()) {
+            for (uint32_t i = node.first; i < node.first + node.count; ++i) {
+                if (!_leaf_bounds[i].intersects_ray(origin, inv_direction, max_dist)) continue;
+                float new_max = callback(_primitives[i], max_dist);
+                if (new_max <= 0.0f) return;
+                max_dist = new_max;
+            }
+        } else {
+            stack[size++] = node.first;
+            stack[size++] = id + 1;
+        }
+    }
+}
+
+}  // namespace engine::physics
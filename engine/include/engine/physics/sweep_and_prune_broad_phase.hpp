@@ -0,0 +1,63 @@
+#pragma once
+
+#include <engine/physics/broad_phase.hpp>
+
+#include <cstdint>
+#include <vector>
+
+namespace engine::physics {
+
+// Sort-and-sweep broad phase. Min/max endpoints of every body are kept in a
+// sorted array per axis across steps; each step only refreshes the values and
+// re-sorts with insertion sort, which is close to O(n) when bodies move
+// coherently (e.g. a crowd of enemies all chasing the player). Added and
+// removed bodies splice their endpoints in and out instead of re-sorting
+// everything, so spawns and deaths keep the sorted state too.
+class SweepAndPruneBroadPhase : public BroadPhase {
+public:
+    SweepAndPruneBroadPhase() = default;
+
+    BroadPhaseType type() const override { return BroadPhaseType::SweepAndPrune; }
+
+    void reset() override { _dirty = true; }
+    void add_proxy(uint32_t index) override;
+    void remove_proxy(uint32_t index, uint32_t last) override;
+
+    void find_pairs(const std::vector<BroadPhaseProxy>& proxies,
+                    std::vector<BodyPair>& out_pairs) override;
+
+    // Axis used by the last sweep (0 = X, 1 = Y, 2 = Z)
+    int sweep_axis() const { return _sweep_axis; }
+
+private:
+    struct Endpoint {
+        float value;
+        uint32_t data;  // (body << 1) | is_max
+
+        uint32_t body() const { return data >> 1; }
+        bool is_max() const { return (data & 1u) != 0; }
+
+        // Min endpoints sort before max endpoints at equal values so that
+        // touching bounds are reported as overlapping
+        bool operator<(const Endpoint& other) const {
+            return value < other.value || (value == other.value && !is_max() && other.is_max());
+        }
+    };
+
+    // Sort key of one endpoint; bodies with non-finite bounds sit at the
+    // end of every axis so NaN can't break the ordering
+    static float endpoint_value(const BroadPhaseProxy& proxy, int axis, bool is_max);
+
+    void rebuild(const std::vector<BroadPhaseProxy>& proxies);
+    void refresh_axis(int axis, const std::vector<BroadPhaseProxy>& proxies);
+    int choose_sweep_axis(const std::vector<BroadPhaseProxy>& proxies) const;
+
+    std::vector<Endpoint> _axes[3];
+    std::vector<uint32_t> _active;
+    std::vector<uint32_t> _active_slot;  // Index of each body in _active
+    size_t _proxy_count = 0;
+    int _sweep_axis = 0;
+    bool _dirty = true;
+};
+
+}  // namespace engine::physics
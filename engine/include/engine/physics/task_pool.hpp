@@ -0,0 +1,54 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace engine::physics {
+
+// Fixed set of worker threads for data-parallel physics work. The calling
+// thread takes part in every parallel_for, so a pool of N threads spawns
+// N - 1 workers.
+class TaskPool {
+public:
+    using RangeFunc = std::function<void(size_t begin, size_t end)>;
+
+    explicit TaskPool(unsigned thread_count);
+    ~TaskPool();
+
+    TaskPool(const TaskPool&) = delete;
+    TaskPool& operator=(const TaskPool&) = delete;
+
+    // Total threads including the caller
+    unsigned thread_count() const { return static_cast<unsigned>(_workers.size()) + 1; }
+
+    // Split [0, count) into chunks of at least min_chunk items and run them
+    // on all threads. Returns once every chunk has finished.
+    void parallel_for(size_t count, size_t min_chunk, const RangeFunc& func);
+
+private:
+    void worker_loop();
+    void run_chunks();
+
+    std::vector<std::thread> _workers;
+
+    std::mutex _mutex;
+    std::condition_variable _wake;
+    std::condition_variable _done;
+
+    // Current job (valid while _busy_workers > 0 or the caller is running it)
+    const RangeFunc* _func = nullptr;
+    size_t _count = 0;
+    size_t _chunk = 1;
+    std::atomic<size_t> _next{0};
+    unsigned _busy_workers = 0;
+    uint64_t _generation = 0;
+    bool _stop = false;
+};
+
+}  // namespace engine::physics
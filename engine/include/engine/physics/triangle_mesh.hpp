@@ -0,0 +1,71 @@
+#pragma once
+
+#include <engine/physics/aabb.hpp>
+#include <engine/physics/static_bvh.hpp>
+
+#include <glm/glm.hpp>
+
+#include <cstdint>
+#include <vector>
+
+namespace engine::physics {
+
+// Triangle in local space. Counter-clockwise winding seen from the front;
+// contacts push bodies out of the front side.
+struct Triangle {
+    glm::vec3 a{0.0f};
+    glm::vec3 b{0.0f};
+    glm::vec3 c{0.0f};
+
+    glm::vec3 normal() const;  // Unit front-face normal (zero if degenerate)
+    AABB bounds() const {
+        return AABB(glm::min(a, glm::min(b, c)), glm::max(a, glm::max(b, c)));
+    }
+};
+
+// Static triangle soup for world collision (arena geometry). Immutable once
+// built; its BVH keeps body-vs-mesh tests logarithmic in the triangle count.
+// Shapes reference the mesh by pointer, so it must outlive every body using it.
+class TriangleMesh {
+public:
+    TriangleMesh() = default;
+
+    // Indexed triangle list, three indices per triangle (MeshData layout)
+    TriangleMesh(std::vector<glm::vec3> vertices, std::vector<uint32_t> indices);
+
+    size_t triangle_count() const { return _indices.size() / 3; }
+    const std::vector<glm::vec3>& vertices() const { return _vertices; }
+    const std::vector<uint32_t>& indices() const { return _indices; }
+
+    Triangle triangle(uint32_t index) const {
+        return Triangle{_vertices[_indices[3 * index]],
+                        _vertices[_indices[3 * index + 1]],
+                        _vertices[_indices[3 * index + 2]]};
+    }
+
+    // Local-space bounds of the whole mesh
+    AABB bounds() const { return _bvh.bounds(); }
+
+    // Visit every triangle whose bounds overlap a local-space box.
+    // callback(const Triangle&) -> bool, return false to stop.
+    template <typename Callback>
+    void query(const AABB& aabb, Callback&& callback) const {
+        _bvh.query(aabb, [&](uint32_t index) { return callback(triangle(index)); });
+    }
+
+    // Visit every triangle whose bounds a local-space ray enters.
+    // callback(const Triangle&, float max_dist) -> float, as StaticBVH::raycast.
+    template <typename Callback>
+    void raycast(glm::vec3 origin, glm::vec3 direction, float max_dist, Callback&& callback) const {
+        _bvh.raycast(origin, direction, max_dist, [&](uint32_t index, float dist) {
+            return callback(triangle(index), dist);
+        });
+    }
+
+private:
+    std::vector<glm::vec3> _vertices;
+    std::vector<uint32_t> _indices;
+    StaticBVH _bvh;
+};
+
+}  // namespace engine::physics
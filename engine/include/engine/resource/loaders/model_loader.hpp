@@ -6,6 +6,7 @@
 #include <functional>
 #include <memory>
 #include <string>
+#include <vector>
 
 namespace engine::resource {
 
@@ -23,6 +24,10 @@ public:
     /// Load model from filepath
     ResourcePtr operator()(const std::string& filepath) const;
 
+    /// Load only the CPU-side mesh data of a model (no GPU upload, materials
+    /// or animations), e.g. to build collision geometry. Empty on failure.
+    static std::vector<pbr::MeshData> load_mesh_data(const std::string& filepath);
+
     /// Identity key for single-argument loaders
     static std::string make_key(const std::string& filepath) {
         return filepath;
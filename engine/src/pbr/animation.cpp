@@ -1,4 +1,5 @@
 #include <engine/pbr/animation.hpp>
+#include <engine/pbr/animation_compression.hpp>
 #include <glm/gtc/matrix_transform.hpp>
 #include <glm/gtx/quaternion.hpp>
 #include <algorithm>
@@ -8,87 +9,140 @@ namespace engine::pbr {
 
 namespace {
 
-/// Find the index of the keyframe just before the given time
+/// Whether index is the keyframe just before the given time: the last key
+/// at or before it (0 before the second key)
 template<typename KeyType>
-size_t find_key_index(const std::vector<KeyType>& keys, float time) {
+bool is_key_index(const std::vector<KeyType>& keys, size_t index, float time) {
+    return (index == 0 || keys[index].time <= time) &&
+           (index + 1 == keys.size() || time < keys[index + 1].time);
+}
+
+/// Find the index of the keyframe just before the given time. The guess from
+/// even spacing or the cursor is checked first, then the key after it
+/// (playback moving forward) and, for rounding in the spacing guess, the key
+/// before; anything else (seeks, loops) falls back to a binary search.
+template<typename KeyType>
+size_t find_key_index(const std::vector<KeyType>& keys, float time,
+                      const KeySpacing& spacing, uint32_t* cursor) {
     if (keys.empty()) return 0;
+    const size_t last = keys.size() - 1;
 
-    for (size_t i = 0; i < keys.size() - 1; ++i) {
-        if (time < keys[i + 1].time) {
-            return i;
-        }
+    size_t guess = cursor ? std::min<size_t>(*cursor, last) : 0;
+    if (spacing.inv_step > 0.0f) {
+        float position = (time - spacing.start) * spacing.inv_step;
+        guess = position > 0.0f ? std::min(static_cast<size_t>(position), last) : 0;
     }
-    return keys.size() - 1;
-}
 
-/// Linear interpolation factor between two keyframes
-float get_interpolation_factor(float time, float time0, float time1) {
-    if (time1 <= time0) return 0.0f;
-    return (time - time0) / (time1 - time0);
+    size_t index;
+    if (is_key_index(keys, guess, time)) {
+        index = guess;
+    } else if (guess < last && is_key_index(keys, guess + 1, time)) {
+        index = guess + 1;
+    } else if (guess > 0 && is_key_index(keys, guess - 1, time)) {
+        index = guess - 1;
+    } else {
+        // First key after the first one that is later than time, minus one
+        auto later = std::upper_bound(keys.begin() + 1, keys.end(), time,
+                                      [](float t, const KeyType& key) { return t < key.time; });
+        index = static_cast<size_t>(later - keys.begin()) - 1;
+    }
+
+    if (cursor) *cursor = static_cast<uint32_t>(index);
+    return index;
 }
 
-/// Recursively calculate bone transforms in the skeleton hierarchy
-void calculate_bone_transform(
-    Skeleton& skeleton,
-    const SkeletonNode* node,
-    const glm::mat4& parent_transform,
-    const std::unordered_map<std::string, size_t>& channel_cache,
-    const std::vector<AnimationChannel>& channels,
-    float animation_time)
-{
-    if (!node) return;
+/// Start and step of evenly spaced keys (within 1% of a step), or no spacing
+template<typename KeyType>
+KeySpacing find_key_spacing(const std::vector<KeyType>& keys) {
+    KeySpacing spacing;
+    if (keys.size() < 2) return spacing;
 
-    glm::mat4 node_transform = node->transformation;
+    float start = keys.front().time;
+    float step = (keys.back().time - start) / static_cast<float>(keys.size() - 1);
+    if (!(step > 0.0f)) return spacing;
 
-    // Use animated transform if available (using cached index lookup)
-    auto it = channel_cache.find(node->name);
-    if (it != channel_cache.end()) {
-        node_transform = channels[it->second].evaluate(animation_time);
+    for (size_t i = 1; i < keys.size(); ++i) {
+        if (std::abs(keys[i].time - (start + step * static_cast<float>(i))) > step * 0.01f) {
+            return spacing;
+        }
     }
 
-    glm::mat4 global_transform = parent_transform * node_transform;
-
-    // If this node is a bone, update its transform
-    int bone_index = skeleton.get_bone_index(node->name);
-    if (bone_index >= 0) {
-        skeleton.set_bone_transform(bone_index, global_transform * (*skeleton.bindpose)[bone_index]);
-    }
+    spacing.start = start;
+    spacing.inv_step = 1.0f / step;
+    return spacing;
+}
 
-    // Process children
-    for (const auto& child : node->children) {
-        calculate_bone_transform(skeleton, &child, global_transform, channel_cache, channels, animation_time);
-    }
+/// Linear interpolation factor between two keyframes
+float get_interpolation_factor(float time, float time0, float time1) {
+    if (time1 <= time0) return 0.0f;
+    return (time - time0) / (time1 - time0);
 }
 
-/// Recursively sample bone transforms (stores to output vector instead of skeleton)
-void sample_bone_transform(
-    const Skeleton& skeleton,
-    const SkeletonNode* node,
-    const glm::mat4& parent_transform,
-    const std::unordered_map<std::string, size_t>& channel_cache,
+/// Evaluate a pose in one pass over the flattened hierarchy: parents come
+/// before children, so each node's global transform is its parent's (already
+/// computed) times its own local one. Bones get global * inverse bind pose.
+void evaluate_pose(
+    const SkeletonHierarchy& hierarchy,
+    const std::vector<int>& node_channels,
     const std::vector<AnimationChannel>& channels,
+    const CompressedAnimation* compressed,
+    ChannelCursor* cursors,
+    const std::vector<glm::mat4>& bindpose,
     float animation_time,
+    std::vector<glm::mat4>& node_transforms,
     std::vector<glm::mat4>& out_transforms)
 {
-    if (!node) return;
+    const size_t node_count = hierarchy.node_count();
+    node_transforms.resize(node_count);
+
+    for (size_t i = 0; i < node_count; ++i) {
+        int channel = node_channels[i];
+        glm::mat4 local = hierarchy.local_transforms[i];
+        if (channel >= 0) {
+            ChannelCursor* cursor = cursors ? &cursors[channel] : nullptr;
+            if (compressed) {
+                glm::vec3 position, scale;
+                glm::quat rotation;
+                compressed->evaluate_trs(channel, animation_time, position, rotation, scale, cursor);
+                local = compose_transform(position, rotation, scale);
+            } else {
+                local = channels[channel].evaluate(animation_time, cursor);
+            }
+        }
 
-    glm::mat4 node_transform = node->transformation;
+        int parent = hierarchy.parents[i];
+        node_transforms[i] = parent >= 0 ? node_transforms[parent] * local : local;
 
-    auto it = channel_cache.find(node->name);
-    if (it != channel_cache.end()) {
-        node_transform = channels[it->second].evaluate(animation_time);
+        int bone_index = hierarchy.bone_indices[i];
+        if (bone_index >= 0 && static_cast<size_t>(bone_index) < out_transforms.size()) {
+            out_transforms[bone_index] = node_transforms[i] * bindpose[bone_index];
+        }
     }
+}
 
-    glm::mat4 global_transform = parent_transform * node_transform;
+/// Normalized lerp of two rotations along the shortest path (q and -q are the
+/// same rotation: flip to the one on from's side)
+glm::quat nlerp(const glm::quat& from, const glm::quat& to, float weight) {
+    glm::quat target = glm::dot(from, to) < 0.0f ? -to : to;
+    return glm::normalize(from * (1.0f - weight) + target * weight);
+}
 
-    int bone_index = skeleton.get_bone_index(node->name);
-    if (bone_index >= 0 && static_cast<size_t>(bone_index) < out_transforms.size()) {
-        out_transforms[bone_index] = global_transform * (*skeleton.bindpose)[bone_index];
+/// Per-axis scale of an additive pose relative to its reference (1 on axes
+/// the reference collapses to zero)
+glm::vec3 scale_delta(const glm::vec3& scale, const glm::vec3& reference) {
+    glm::vec3 ratio(1.0f);
+    for (int axis = 0; axis < 3; ++axis) {
+        if (reference[axis] != 0.0f) ratio[axis] = scale[axis] / reference[axis];
     }
+    return ratio;
+}
 
-    for (const auto& child : node->children) {
-        sample_bone_transform(skeleton, &child, global_transform, channel_cache, channels, animation_time, out_transforms);
-    }
+/// Wrap a time into [0, duration) (unchanged for clips without a duration)
+float wrap_time(float time, float duration) {
+    if (duration <= 0.0f) return time;
+
+    float wrapped = std::fmod(time, duration);
+    return wrapped < 0.0f ? wrapped + duration : wrapped;
 }
 
 }  // namespace
@@ -97,7 +151,7 @@ void sample_bone_transform(
 // AnimationChannel
 // ============================================================================
 
-glm::vec3 AnimationChannel::interpolate_position(float time) const {
+glm::vec3 AnimationChannel::interpolate_position(float time, uint32_t* cursor) const {
     if (position_keys.empty()) {
         return glm::vec3(0.0f);
     }
@@ -106,7 +160,7 @@ glm::vec3 AnimationChannel::interpolate_position(float time) const {
         return position_keys[0].value;
     }
 
-    size_t index = find_key_index(position_keys, time);
+    size_t index = find_key_index(position_keys, time, _position_spacing, cursor);
 
     if (index >= position_keys.size() - 1) {
         return position_keys.back().value;
@@ -119,7 +173,7 @@ glm::vec3 AnimationChannel::interpolate_position(float time) const {
     return glm::mix(key0.value, key1.value, factor);
 }
 
-glm::quat AnimationChannel::interpolate_rotation(float time) const {
+glm::quat AnimationChannel::interpolate_rotation(float time, uint32_t* cursor) const {
     if (rotation_keys.empty()) {
         return glm::quat(1.0f, 0.0f, 0.0f, 0.0f);
     }
@@ -128,7 +182,7 @@ glm::quat AnimationChannel::interpolate_rotation(float time) const {
         return rotation_keys[0].value;
     }
 
-    size_t index = find_key_index(rotation_keys, time);
+    size_t index = find_key_index(rotation_keys, time, _rotation_spacing, cursor);
 
     if (index >= rotation_keys.size() - 1) {
         return rotation_keys.back().value;
@@ -141,7 +195,7 @@ glm::quat AnimationChannel::interpolate_rotation(float time) const {
     return glm::slerp(key0.value, key1.value, factor);
 }
 
-glm::vec3 AnimationChannel::interpolate_scale(float time) const {
+glm::vec3 AnimationChannel::interpolate_scale(float time, uint32_t* cursor) const {
     if (scale_keys.empty()) {
         return glm::vec3(1.0f);
     }
@@ -150,7 +204,7 @@ glm::vec3 AnimationChannel::interpolate_scale(float time) const {
         return scale_keys[0].value;
     }
 
-    size_t index = find_key_index(scale_keys, time);
+    size_t index = find_key_index(scale_keys, time, _scale_spacing, cursor);
 
     if (index >= scale_keys.size() - 1) {
         return scale_keys.back().value;
@@ -163,73 +217,182 @@ glm::vec3 AnimationChannel::interpolate_scale(float time) const {
     return glm::mix(key0.value, key1.value, factor);
 }
 
-glm::mat4 AnimationChannel::evaluate(float time) const {
-    glm::vec3 position = interpolate_position(time);
-    glm::quat rotation = interpolate_rotation(time);
-    glm::vec3 scale = interpolate_scale(time);
+glm::mat4 AnimationChannel::evaluate(float time, ChannelCursor* cursor) const {
+    glm::vec3 position;
+    glm::quat rotation;
+    glm::vec3 scale;
+    evaluate_trs(time, position, rotation, scale, cursor);
+    return compose_transform(position, rotation, scale);
+}
 
-    // Build transformation matrix: T * R * S
-    glm::mat4 transform = glm::scale(glm::mat4(1.0f), scale);
-    transform = glm::toMat4(rotation) * transform;
-    transform = glm::translate(glm::mat4(1.0f), position) * transform;
+void AnimationChannel::evaluate_trs(float time, glm::vec3& position, glm::quat& rotation, glm::vec3& scale,
+                                    ChannelCursor* cursor) const {
+    position = interpolate_position(time, cursor ? &cursor->position : nullptr);
+    rotation = interpolate_rotation(time, cursor ? &cursor->rotation : nullptr);
+    scale = interpolate_scale(time, cursor ? &cursor->scale : nullptr);
+}
 
-    return transform;
+void AnimationChannel::update_key_spacing() {
+    _position_spacing = find_key_spacing(position_keys);
+    _rotation_spacing = find_key_spacing(rotation_keys);
+    _scale_spacing = find_key_spacing(scale_keys);
 }
 
 // ============================================================================
 // AnimationClip
 // ============================================================================
 
-void AnimationClip::build_cache(const Skeleton& /*skeleton*/) const {
-    if (_cache_built) return;
+void AnimationClip::build_cache(const Skeleton& skeleton) const {
+    const SkeletonHierarchy* hierarchy = skeleton.hierarchy.get();
+    if (!hierarchy || _bound_hierarchy.lock().get() == hierarchy) return;
 
-    _channel_index_cache.clear();
+    // Name lookups happen here once, never while evaluating poses
+    std::unordered_map<std::string, int> channel_indices;
     for (size_t i = 0; i < _channels.size(); ++i) {
-        _channel_index_cache[_channels[i].bone_name] = i;
+        channel_indices[_channels[i].bone_name] = static_cast<int>(i);
+    }
+
+    _node_channels.assign(hierarchy->node_count(), -1);
+    for (size_t node = 0; node < hierarchy->node_count(); ++node) {
+        auto it = channel_indices.find(hierarchy->names[node]);
+        if (it != channel_indices.end()) {
+            _node_channels[node] = it->second;
+        }
     }
-    _cache_built = true;
+    _bound_hierarchy = skeleton.hierarchy;
 }
 
-void AnimationClip::apply(Skeleton& skeleton, float time) const {
-    if (_channels.empty() || !skeleton.bone_index_map) {
-        return;
+void AnimationClip::compress(const AnimationCompressionSettings& settings) {
+    if (_compressed) return;
+
+    _compressed = CompressedAnimation::build(_channels, _duration, settings);
+
+    // Only the names are still needed, to bind channels to nodes
+    for (auto& channel : _channels) {
+        channel.position_keys = {};
+        channel.rotation_keys = {};
+        channel.scale_keys = {};
+        channel.update_key_spacing();
     }
+}
 
-    if (!_cache_built) {
-        build_cache(skeleton);
+void AnimationClip::evaluate_channel(size_t channel, float time, glm::vec3& position, glm::quat& rotation,
+                                     glm::vec3& scale, ChannelCursor* cursor) const {
+    if (_compressed) {
+        _compressed->evaluate_trs(channel, time, position, rotation, scale, cursor);
+    } else {
+        _channels[channel].evaluate_trs(time, position, rotation, scale, cursor);
     }
+}
+
+void AnimationClip::apply(Skeleton& skeleton, float time, std::vector<ChannelCursor>* cursors) const {
+    sample(time, skeleton.transforms, skeleton, cursors);
+}
 
-    float animation_time = time;
-    if (_duration > 0.0f) {
-        animation_time = std::fmod(time, _duration);
-        if (animation_time < 0.0f) {
-            animation_time += _duration;
+void AnimationClip::sample(float time, std::vector<glm::mat4>& out_transforms, const Skeleton& skeleton,
+                           std::vector<ChannelCursor>* cursors) const {
+    if (_channels.empty() || !skeleton.hierarchy || !skeleton.bindpose) {
+        return;
+    }
+
+    build_cache(skeleton);
+
+    ChannelCursor* channel_cursors = nullptr;
+    if (cursors) {
+        if (cursors->size() != _channels.size()) {
+            cursors->assign(_channels.size(), ChannelCursor());
         }
+        channel_cursors = cursors->data();
     }
 
-    calculate_bone_transform(skeleton, skeleton.root_node.get(), glm::mat4(1.0f),
-                            _channel_index_cache, _channels, animation_time);
+    evaluate_pose(*skeleton.hierarchy, _node_channels, _channels, _compressed.get(), channel_cursors,
+                  *skeleton.bindpose, wrap_time(time, _duration), skeleton.node_transforms, out_transforms);
 }
 
-void AnimationClip::sample(float time, std::vector<glm::mat4>& out_transforms, const Skeleton& skeleton) const {
-    if (_channels.empty() || !skeleton.bone_index_map) {
+void AnimationClip::sample_pose(float time, const Skeleton& skeleton, LocalPose& out_pose,
+                                std::vector<ChannelCursor>* cursors) const {
+    if (!skeleton.hierarchy) {
         return;
     }
 
-    if (!_cache_built) {
-        build_cache(skeleton);
+    // Start from the rest pose; animated nodes are overwritten below
+    const LocalPose& rest = skeleton.hierarchy->rest_pose;
+    out_pose.translations.assign(rest.translations.begin(), rest.translations.end());
+    out_pose.rotations.assign(rest.rotations.begin(), rest.rotations.end());
+    out_pose.scales.assign(rest.scales.begin(), rest.scales.end());
+
+    if (_channels.empty()) {
+        return;
     }
 
-    float animation_time = time;
-    if (_duration > 0.0f) {
-        animation_time = std::fmod(time, _duration);
-        if (animation_time < 0.0f) {
-            animation_time += _duration;
+    build_cache(skeleton);
+
+    ChannelCursor* channel_cursors = nullptr;
+    if (cursors) {
+        if (cursors->size() != _channels.size()) {
+            cursors->assign(_channels.size(), ChannelCursor());
         }
+        channel_cursors = cursors->data();
     }
 
-    sample_bone_transform(skeleton, skeleton.root_node.get(), glm::mat4(1.0f),
-                         _channel_index_cache, _channels, animation_time, out_transforms);
+    float animation_time = wrap_time(time, _duration);
+    for (size_t i = 0; i < _node_channels.size(); ++i) {
+        int channel = _node_channels[i];
+        if (channel < 0) continue;
+
+        ChannelCursor* cursor = channel_cursors ? &channel_cursors[channel] : nullptr;
+        evaluate_channel(channel, animation_time, out_pose.translations[i], out_pose.rotations[i],
+                         out_pose.scales[i], cursor);
+    }
+}
+
+void blend_poses(const LocalPose& from, const LocalPose& to, float weight, LocalPose& out_pose,
+                 const BoneMask* mask) {
+    const size_t node_count = std::min(from.size(), to.size());
+    out_pose.resize(node_count);
+
+    for (size_t i = 0; i < node_count; ++i) {
+        float node_weight = mask ? weight * mask->weight(i) : weight;
+        if (node_weight <= 0.0f) {
+            if (&out_pose != &from) {
+                out_pose.translations[i] = from.translations[i];
+                out_pose.rotations[i] = from.rotations[i];
+                out_pose.scales[i] = from.scales[i];
+            }
+            continue;
+        }
+
+        out_pose.translations[i] = glm::mix(from.translations[i], to.translations[i], node_weight);
+        out_pose.scales[i] = glm::mix(from.scales[i], to.scales[i], node_weight);
+        out_pose.rotations[i] = nlerp(from.rotations[i], to.rotations[i], node_weight);
+    }
+}
+
+void add_additive_pose(const LocalPose& base, const LocalPose& additive, const LocalPose& reference,
+                       float weight, LocalPose& out_pose, const BoneMask* mask) {
+    const size_t node_count = std::min({base.size(), additive.size(), reference.size()});
+    out_pose.resize(node_count);
+
+    const glm::quat identity(1.0f, 0.0f, 0.0f, 0.0f);
+    for (size_t i = 0; i < node_count; ++i) {
+        float node_weight = mask ? weight * mask->weight(i) : weight;
+        if (node_weight <= 0.0f) {
+            if (&out_pose != &base) {
+                out_pose.translations[i] = base.translations[i];
+                out_pose.rotations[i] = base.rotations[i];
+                out_pose.scales[i] = base.scales[i];
+            }
+            continue;
+        }
+
+        glm::vec3 translation_delta = additive.translations[i] - reference.translations[i];
+        glm::quat rotation_delta = glm::inverse(reference.rotations[i]) * additive.rotations[i];
+        glm::vec3 scale_ratio = scale_delta(additive.scales[i], reference.scales[i]);
+
+        out_pose.translations[i] = base.translations[i] + translation_delta * node_weight;
+        out_pose.rotations[i] = glm::normalize(base.rotations[i] * nlerp(identity, rotation_delta, node_weight));
+        out_pose.scales[i] = base.scales[i] * glm::mix(glm::vec3(1.0f), scale_ratio, node_weight);
+    }
 }
 
 // ============================================================================
@@ -243,6 +406,8 @@ void AnimationState::crossfade_to(std::shared_ptr<AnimationClip> clip, float dur
     _prev_clip = _clip;
     _prev_time = _current_time;
     _prev_looping = _looping;
+    _prev_cursors.swap(_cursors);
+    _cursors.clear();
 
     // Set new animation
     _clip = clip;
@@ -318,26 +483,25 @@ void AnimationState::apply(Skeleton& skeleton) const {
 
     if (_blend_factor >= 1.0f || !_prev_clip) {
         // No blending, just apply current animation
-        _clip->apply(skeleton, _current_time);
+        _clip->apply(skeleton, _current_time, &_cursors);
     } else {
-        // Blending between previous and current animation
-        size_t bone_count = skeleton.get_bone_count();
-
-        // Sample both animations
-        std::vector<glm::mat4> prev_transforms(bone_count, glm::mat4(1.0f));
-        std::vector<glm::mat4> curr_transforms(bone_count, glm::mat4(1.0f));
-
-        _prev_clip->sample(_prev_time, prev_transforms, skeleton);
-        _clip->sample(_current_time, curr_transforms, skeleton);
-
-        // Blend transforms (simple linear interpolation of matrices)
-        // Note: For better quality, decompose to TRS and interpolate separately
-        for (size_t i = 0; i < bone_count; ++i) {
-            glm::mat4 blended = prev_transforms[i] * (1.0f - _blend_factor) +
-                               curr_transforms[i] * _blend_factor;
-            skeleton.set_bone_transform(i, blended);
-        }
+        // Blend the two clips' local poses, then build matrices once
+        sample_pose(skeleton, _pose);
+        skeleton.apply_pose(_pose);
+    }
+}
+
+bool AnimationState::sample_pose(const Skeleton& skeleton, LocalPose& out_pose) const {
+    if (!_clip || !skeleton.hierarchy) return false;
+
+    if (_blend_factor >= 1.0f || !_prev_clip) {
+        _clip->sample_pose(_current_time, skeleton, out_pose, &_cursors);
+    } else {
+        _prev_clip->sample_pose(_prev_time, skeleton, _prev_pose, &_prev_cursors);
+        _clip->sample_pose(_current_time, skeleton, out_pose, &_cursors);
+        blend_poses(_prev_pose, out_pose, _blend_factor, out_pose);
     }
+    return true;
 }
 
 float AnimationState::progress() const {
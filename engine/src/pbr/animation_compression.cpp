@@ -0,0 +1,377 @@
+#include <engine/pbr/animation_compression.hpp>
+#include <glm/gtx/quaternion.hpp>
+
+#include <algorithm>
+#include <cmath>
+
+namespace engine::pbr {
+
+namespace {
+
+constexpr float QUANTIZED_MAX = 65535.0f;
+
+// Smallest three: the three smaller components of a unit quaternion lie in
+// [-1/sqrt(2), 1/sqrt(2)] and are stored in 15 bits each
+constexpr float SMALLEST_THREE_RANGE = 0.70710678f;
+constexpr float SMALLEST_THREE_MAX = 32767.0f;
+
+// Most keys one interpolated segment may replace: bounds the checks per key,
+// so key reduction stays linear in the number of keys
+constexpr size_t MAX_SEGMENT_KEYS = 64;
+
+template<typename KeyType>
+float interpolation_factor(const KeyType& from, const KeyType& to, float time) {
+    return to.time > from.time ? (time - from.time) / (to.time - from.time) : 0.0f;
+}
+
+glm::vec3 interpolate(const PositionKey& from, const PositionKey& to, float time) {
+    return glm::mix(from.value, to.value, interpolation_factor(from, to, time));
+}
+
+glm::vec3 interpolate(const ScaleKey& from, const ScaleKey& to, float time) {
+    return glm::mix(from.value, to.value, interpolation_factor(from, to, time));
+}
+
+glm::quat interpolate(const RotationKey& from, const RotationKey& to, float time) {
+    return glm::slerp(from.value, to.value, interpolation_factor(from, to, time));
+}
+
+float key_error(const glm::vec3& a, const glm::vec3& b) {
+    glm::vec3 diff = glm::abs(a - b);
+    return std::max(diff.x, std::max(diff.y, diff.z));
+}
+
+float key_error(const glm::quat& a, const glm::quat& b) {
+    // q and -q are the same rotation
+    glm::quat c = glm::dot(a, b) < 0.0f ? -b : b;
+    return std::max(std::max(std::abs(a.x - c.x), std::abs(a.y - c.y)),
+                    std::max(std::abs(a.z - c.z), std::abs(a.w - c.w)));
+}
+
+uint16_t quantize(float value, float min, float step) {
+    if (step <= 0.0f) return 0;
+    float q = std::round((value - min) / step);
+    return static_cast<uint16_t>(std::min(std::max(q, 0.0f), QUANTIZED_MAX));
+}
+
+uint16_t quantize_time(float time, float time_scale) {
+    return quantize(time, 0.0f, time_scale > 0.0f ? 1.0f / time_scale : 0.0f);
+}
+
+void encode_smallest_three(const glm::quat& rotation, uint16_t* out) {
+    float components[4] = {rotation.x, rotation.y, rotation.z, rotation.w};
+
+    int largest = 0;
+    for (int i = 1; i < 4; ++i) {
+        if (std::abs(components[i]) > std::abs(components[largest])) largest = i;
+    }
+
+    // Make the dropped component positive so it can be rebuilt with sqrt
+    float sign = components[largest] < 0.0f ? -1.0f : 1.0f;
+    uint16_t small[3];
+    for (int i = 0, j = 0; i < 4; ++i) {
+        if (i == largest) continue;
+        float normalized = components[i] * sign / SMALLEST_THREE_RANGE * 0.5f + 0.5f;
+        float q = std::round(normalized * SMALLEST_THREE_MAX);
+        small[j++] = static_cast<uint16_t>(std::min(std::max(q, 0.0f), SMALLEST_THREE_MAX));
+    }
+
+    // Two bits of largest component index in the top bits of the first two words
+    out[0] = static_cast<uint16_t>(small[0] | ((largest >> 1) << 15));
+    out[1] = static_cast<uint16_t>(small[1] | ((largest & 1) << 15));
+    out[2] = small[2];
+}
+
+glm::quat decode_smallest_three(const uint16_t* value) {
+    int largest = ((value[0] >> 15) << 1) | (value[1] >> 15);
+
+    float small[3];
+    float sum = 0.0f;
+    for (int i = 0; i < 3; ++i) {
+        float q = static_cast<float>(value[i] & 0x7fff);
+        small[i] = (q / SMALLEST_THREE_MAX - 0.5f) * 2.0f * SMALLEST_THREE_RANGE;
+        sum += small[i] * small[i];
+    }
+
+    float components[4];
+    for (int i = 0, j = 0; i < 4; ++i) {
+        components[i] = i == largest ? std::sqrt(std::max(1.0f - sum, 0.0f)) : small[j++];
+    }
+    return glm::quat(components[3], components[0], components[1], components[2]);
+}
+
+/// A key as sampling will see it: time and value quantized and decoded
+float round_trip_time(float time, float time_scale) {
+    return time_scale > 0.0f ? quantize_time(time, time_scale) / time_scale : 0.0f;
+}
+
+glm::vec3 round_trip(const glm::vec3& value, const glm::vec3& min, const glm::vec3& step) {
+    glm::vec3 q(quantize(value.x, min.x, step.x), quantize(value.y, min.y, step.y),
+                quantize(value.z, min.z, step.z));
+    return min + q * step;
+}
+
+glm::quat round_trip(const glm::quat& rotation) {
+    uint16_t value[3];
+    encode_smallest_three(glm::normalize(rotation), value);
+    return decode_smallest_three(value);
+}
+
+/// Indices of the keys to keep: greedily extend each segment from the last
+/// kept key while interpolating across it rebuilds every key in between.
+/// Segments interpolate the decoded keys, so the tolerance bounds the error
+/// of what is sampled, quantization included.
+template<typename KeyType>
+std::vector<size_t> reduce_keys(const std::vector<KeyType>& keys, const std::vector<KeyType>& decoded,
+                                float tolerance) {
+    std::vector<size_t> kept;
+    if (keys.empty()) return kept;
+
+    // Constant tracks keep one key
+    bool constant = true;
+    for (const KeyType& key : keys) {
+        if (key_error(decoded.front().value, key.value) > tolerance) {
+            constant = false;
+            break;
+        }
+    }
+    kept.push_back(0);
+    if (constant) return kept;
+
+    size_t anchor = 0;
+    for (size_t end = 2; end < keys.size(); ++end) {
+        bool fits = end - anchor <= MAX_SEGMENT_KEYS;
+        for (size_t key = anchor + 1; fits && key < end; ++key) {
+            fits = key_error(interpolate(decoded[anchor], decoded[end], keys[key].time),
+                             keys[key].value) <= tolerance;
+        }
+        if (!fits) {
+            anchor = end - 1;
+            kept.push_back(anchor);
+        }
+    }
+    kept.push_back(keys.size() - 1);
+    return kept;
+}
+
+/// Reduce a vector track and append its kept keys
+template<typename KeyType>
+void append_vector_track(const std::vector<KeyType>& keys, float tolerance, float time_scale,
+                         const glm::vec3& min, const glm::vec3& step, std::vector<KeyType>& decoded,
+                         std::vector<uint16_t>& times, std::vector<uint16_t>& values) {
+    decoded.resize(keys.size());
+    for (size_t i = 0; i < keys.size(); ++i) {
+        decoded[i].time = round_trip_time(keys[i].time, time_scale);
+        decoded[i].value = round_trip(keys[i].value, min, step);
+    }
+
+    for (size_t index : reduce_keys(keys, decoded, tolerance)) {
+        times.push_back(quantize_time(keys[index].time, time_scale));
+        for (int axis = 0; axis < 3; ++axis) {
+            values.push_back(quantize(keys[index].value[axis], min[axis], step[axis]));
+        }
+    }
+}
+
+/// Bounds of a vector track type over the whole clip
+template<typename KeyType>
+void grow_bounds(const std::vector<KeyType>& keys, glm::vec3& min, glm::vec3& max) {
+    for (const KeyType& key : keys) {
+        min = glm::min(min, key.value);
+        max = glm::max(max, key.value);
+    }
+}
+
+template<typename KeyType>
+void grow_time_range(const std::vector<KeyType>& keys, float& range) {
+    if (!keys.empty()) range = std::max(range, keys.back().time);
+}
+
+}  // namespace
+
+std::shared_ptr<CompressedAnimation> CompressedAnimation::build(
+    const std::vector<AnimationChannel>& channels, float duration,
+    const AnimationCompressionSettings& settings)
+{
+    auto compressed = std::make_shared<CompressedAnimation>();
+
+    // Quantization ranges first: key reduction measures its error on the
+    // quantized keys
+    float time_range = duration;
+    glm::vec3 position_min(INFINITY), position_max(-INFINITY);
+    glm::vec3 scale_min(INFINITY), scale_max(-INFINITY);
+
+    for (const AnimationChannel& channel : channels) {
+        grow_bounds(channel.position_keys, position_min, position_max);
+        grow_bounds(channel.scale_keys, scale_min, scale_max);
+
+        grow_time_range(channel.position_keys, time_range);
+        grow_time_range(channel.rotation_keys, time_range);
+        grow_time_range(channel.scale_keys, time_range);
+    }
+
+    // A whole number of steps per tick keeps keys baked on ticks exact
+    if (time_range > 0.0f) {
+        float time_scale = QUANTIZED_MAX / time_range;
+        compressed->_time_scale = time_scale >= 1.0f ? std::floor(time_scale) : time_scale;
+    }
+    if (position_min.x <= position_max.x) {
+        compressed->_position_min = position_min;
+        compressed->_position_step = (position_max - position_min) / QUANTIZED_MAX;
+    }
+    if (scale_min.x <= scale_max.x) {
+        compressed->_scale_min = scale_min;
+        compressed->_scale_step = (scale_max - scale_min) / QUANTIZED_MAX;
+    }
+
+    // Decoded keys of the track being reduced (reused across tracks)
+    std::vector<PositionKey> decoded_positions;
+    std::vector<RotationKey> decoded_rotations;
+    std::vector<ScaleKey> decoded_scales;
+
+    const float time_scale = compressed->_time_scale;
+    compressed->_channels.resize(channels.size());
+    for (size_t i = 0; i < channels.size(); ++i) {
+        const AnimationChannel& channel = channels[i];
+        ChannelTracks& tracks = compressed->_channels[i];
+
+        tracks.position.first_key = static_cast<uint32_t>(compressed->_position_times.size());
+        append_vector_track(channel.position_keys, settings.position_tolerance, time_scale,
+                            compressed->_position_min, compressed->_position_step, decoded_positions,
+                            compressed->_position_times, compressed->_position_values);
+        tracks.position.key_count =
+            static_cast<uint32_t>(compressed->_position_times.size()) - tracks.position.first_key;
+
+        tracks.rotation.first_key = static_cast<uint32_t>(compressed->_rotation_times.size());
+        decoded_rotations.resize(channel.rotation_keys.size());
+        for (size_t k = 0; k < channel.rotation_keys.size(); ++k) {
+            decoded_rotations[k].time = round_trip_time(channel.rotation_keys[k].time, time_scale);
+            decoded_rotations[k].value = round_trip(channel.rotation_keys[k].value);
+        }
+        for (size_t index : reduce_keys(channel.rotation_keys, decoded_rotations, settings.rotation_tolerance)) {
+            const RotationKey& key = channel.rotation_keys[index];
+            compressed->_rotation_times.push_back(quantize_time(key.time, time_scale));
+            compressed->_rotation_values.resize(compressed->_rotation_values.size() + 3);
+            encode_smallest_three(glm::normalize(key.value),
+                                  &compressed->_rotation_values[compressed->_rotation_values.size() - 3]);
+        }
+        tracks.rotation.key_count =
+            static_cast<uint32_t>(compressed->_rotation_times.size()) - tracks.rotation.first_key;
+
+        tracks.scale.first_key = static_cast<uint32_t>(compressed->_scale_times.size());
+        append_vector_track(channel.scale_keys, settings.scale_tolerance, time_scale,
+                            compressed->_scale_min, compressed->_scale_step, decoded_scales,
+                            compressed->_scale_times, compressed->_scale_values);
+        tracks.scale.key_count =
+            static_cast<uint32_t>(compressed->_scale_times.size()) - tracks.scale.first_key;
+    }
+
+    return compressed;
+}
+
+size_t CompressedAnimation::find_key(const std::vector<uint16_t>& times, const Track& track, float time,
+                                     uint32_t* cursor) const {
+    const uint16_t* keys = times.data() + track.first_key;
+    const size_t count = track.key_count;
+
+    auto is_key = [&](size_t index) {
+        return (index == 0 || keys[index] <= time) && (index + 1 == count || time < keys[index + 1]);
+    };
+
+    // Same order as for loaded keys: cursor, the key after it, then a binary search
+    size_t guess = cursor ? std::min<size_t>(*cursor, count - 1) : 0;
+    size_t index;
+    if (is_key(guess)) {
+        index = guess;
+    } else if (guess + 1 < count && is_key(guess + 1)) {
+        index = guess + 1;
+    } else {
+        size_t low = 1, high = count;
+        while (low < high) {
+            size_t mid = (low + high) / 2;
+            if (time < keys[mid]) {
+                high = mid;
+            } else {
+                low = mid + 1;
+            }
+        }
+        index = low - 1;
+    }
+
+    if (cursor) *cursor = static_cast<uint32_t>(index);
+    return index;
+}
+
+void CompressedAnimation::find_keys(const std::vector<uint16_t>& times, const Track& track, float time,
+                                    uint32_t* cursor, size_t& first, size_t& second, float& factor) const {
+    size_t index = track.key_count > 1 ? find_key(times, track, time, cursor) : 0;
+
+    first = track.first_key + index;
+    second = first;
+    factor = 0.0f;
+    if (index + 1 < track.key_count) {
+        second = first + 1;
+        float time0 = times[first];
+        float time1 = times[second];
+        factor = time1 > time0 ? std::min(std::max((time - time0) / (time1 - time0), 0.0f), 1.0f) : 0.0f;
+    }
+}
+
+glm::vec3 CompressedAnimation::decode_position(size_t key) const {
+    const uint16_t* value = &_position_values[key * 3];
+    return _position_min + glm::vec3(value[0], value[1], value[2]) * _position_step;
+}
+
+glm::vec3 CompressedAnimation::decode_scale(size_t key) const {
+    const uint16_t* value = &_scale_values[key * 3];
+    return _scale_min + glm::vec3(value[0], value[1], value[2]) * _scale_step;
+}
+
+glm::quat CompressedAnimation::decode_rotation(size_t key) const {
+    return decode_smallest_three(&_rotation_values[key * 3]);
+}
+
+void CompressedAnimation::evaluate_trs(size_t channel, float time, glm::vec3& position, glm::quat& rotation,
+                                       glm::vec3& scale, ChannelCursor* cursor) const {
+    const ChannelTracks& tracks = _channels[channel];
+    const float quantized_time = time * _time_scale;
+
+    size_t first, second;
+    float factor;
+
+    if (tracks.position.key_count == 0) {
+        position = glm::vec3(0.0f);
+    } else {
+        find_keys(_position_times, tracks.position, quantized_time, cursor ? &cursor->position : nullptr,
+                  first, second, factor);
+        position = first == second ? decode_position(first)
+                                   : glm::mix(decode_position(first), decode_position(second), factor);
+    }
+
+    if (tracks.rotation.key_count == 0) {
+        rotation = glm::quat(1.0f, 0.0f, 0.0f, 0.0f);
+    } else {
+        find_keys(_rotation_times, tracks.rotation, quantized_time, cursor ? &cursor->rotation : nullptr,
+                  first, second, factor);
+        rotation = first == second ? decode_rotation(first)
+                                   : glm::slerp(decode_rotation(first), decode_rotation(second), factor);
+    }
+
+    if (tracks.scale.key_count == 0) {
+        scale = glm::vec3(1.0f);
+    } else {
+        find_keys(_scale_times, tracks.scale, quantized_time, cursor ? &cursor->scale : nullptr,
+                  first, second, factor);
+        scale = first == second ? decode_scale(first)
+                                : glm::mix(decode_scale(first), decode_scale(second), factor);
+    }
+}
+
+size_t CompressedAnimation::memory_usage() const {
+    size_t key_bytes = sizeof(uint16_t) * (_position_times.size() + _position_values.size() +
+                                           _rotation_times.size() + _rotation_values.size() +
+                                           _scale_times.size() + _scale_values.size());
+    return sizeof(*this) + key_bytes + _channels.size() * sizeof(ChannelTracks);
+}
+
+}  // namespace engine::pbr
@@ -0,0 +1,207 @@
+#include <engine/pbr/animation_graph.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+namespace engine::pbr {
+
+namespace {
+
+/// Length of one cycle of a clip in seconds
+float clip_seconds(const AnimationClip& clip) {
+    float ticks_per_second = clip.ticks_per_second() > 0.0f ? clip.ticks_per_second() : 25.0f;
+    return clip.duration() / ticks_per_second;
+}
+
+}  // namespace
+
+// ============================================================================
+// BlendSpace1D
+// ============================================================================
+
+void BlendSpace1D::add_clip(std::shared_ptr<AnimationClip> clip, float position) {
+    if (!clip) return;
+
+    Entry entry;
+    entry.clip = std::move(clip);
+    entry.position = position;
+
+    auto it = std::upper_bound(_entries.begin(), _entries.end(), position,
+                               [](float p, const Entry& e) { return p < e.position; });
+    _entries.insert(it, std::move(entry));
+}
+
+void BlendSpace1D::find_blend(size_t& first, size_t& second, float& weight) const {
+    first = 0;
+    second = 0;
+    weight = 0.0f;
+    if (_entries.size() < 2 || _parameter <= _entries.front().position) return;
+
+    if (_parameter >= _entries.back().position) {
+        first = second = _entries.size() - 1;
+        return;
+    }
+
+    while (second + 1 < _entries.size() && _entries[second].position <= _parameter) {
+        ++second;
+    }
+    first = second - 1;
+
+    float span = _entries[second].position - _entries[first].position;
+    weight = span > 0.0f ? (_parameter - _entries[first].position) / span : 0.0f;
+}
+
+void BlendSpace1D::update(float delta_time, float speed) {
+    if (_entries.empty()) return;
+
+    size_t first, second;
+    float weight;
+    find_blend(first, second, weight);
+
+    // Cycle length of the blend, so both clips advance one cycle together
+    float cycle = clip_seconds(*_entries[first].clip) * (1.0f - weight) +
+                  clip_seconds(*_entries[second].clip) * weight;
+    if (cycle <= 0.0f) return;
+
+    _phase += delta_time * speed / cycle;
+    _phase -= std::floor(_phase);
+}
+
+bool BlendSpace1D::sample_pose(const Skeleton& skeleton, LocalPose& out_pose) const {
+    if (_entries.empty() || !skeleton.hierarchy) return false;
+
+    size_t first, second;
+    float weight;
+    find_blend(first, second, weight);
+
+    const Entry& a = _entries[first];
+    a.clip->sample_pose(_phase * a.clip->duration(), skeleton, out_pose, &a.cursors);
+
+    if (second != first && weight > 0.0f) {
+        const Entry& b = _entries[second];
+        b.clip->sample_pose(_phase * b.clip->duration(), skeleton, _scratch, &b.cursors);
+        blend_poses(out_pose, _scratch, weight, out_pose);
+    }
+    return true;
+}
+
+// ============================================================================
+// AnimationLayer
+// ============================================================================
+
+void AnimationLayer::play(std::shared_ptr<AnimationClip> clip, float fade_duration, bool loop) {
+    _blend_space.reset();
+
+    if (fade_duration > 0.0f && _state.clip()) {
+        _state.crossfade_to(std::move(clip), fade_duration, loop);
+    } else {
+        _state.set_clip(std::move(clip));
+        _state.set_looping(loop);
+        _state.play();
+    }
+}
+
+void AnimationLayer::set_blend_space(std::shared_ptr<BlendSpace1D> blend_space) {
+    _blend_space = std::move(blend_space);
+    _state.set_clip(nullptr);
+}
+
+void AnimationLayer::fade_to(float weight, float duration) {
+    if (duration <= 0.0f) {
+        set_weight(weight);
+        return;
+    }
+    _target_weight = weight;
+    _fade_rate = std::abs(weight - _weight) / duration;
+}
+
+void AnimationLayer::update(float delta_time) {
+    if (_blend_space) {
+        _blend_space->update(delta_time, _state.speed());
+    } else {
+        _state.update(delta_time);
+    }
+
+    if (_weight != _target_weight) {
+        float step = _fade_rate * delta_time;
+        if (_fade_rate <= 0.0f || std::abs(_target_weight - _weight) <= step) {
+            _weight = _target_weight;
+        } else {
+            _weight += _target_weight > _weight ? step : -step;
+        }
+    }
+}
+
+bool AnimationLayer::sample_pose(const Skeleton& skeleton, LocalPose& out_pose) const {
+    if (_blend_space) {
+        return _blend_space->sample_pose(skeleton, out_pose);
+    }
+    return _state.sample_pose(skeleton, out_pose);
+}
+
+const LocalPose& AnimationLayer::reference_pose(const Skeleton& skeleton) const {
+    const SkeletonHierarchy* hierarchy = skeleton.hierarchy.get();
+    if (hierarchy && _reference_hierarchy.lock().get() != hierarchy) {
+        if (_reference_clip) {
+            _reference_clip->sample_pose(0.0f, skeleton, _reference_pose);
+        } else {
+            _reference_pose = hierarchy->rest_pose;
+        }
+        _reference_hierarchy = skeleton.hierarchy;
+    }
+    return _reference_pose;
+}
+
+// ============================================================================
+// AnimationGraph
+// ============================================================================
+
+AnimationLayer& AnimationGraph::add_layer() {
+    _layers.push_back(std::make_unique<AnimationLayer>());
+    return *_layers.back();
+}
+
+void AnimationGraph::update(float delta_time) {
+    for (auto& layer : _layers) {
+        layer->update(delta_time);
+    }
+}
+
+void AnimationGraph::apply(Skeleton& skeleton) const {
+    if (!skeleton.hierarchy) return;
+
+    bool has_pose = false;
+    for (const auto& layer : _layers) {
+        float weight = layer->weight();
+        if (weight <= 0.0f) continue;
+
+        const BoneMask* mask = layer->mask().get();
+        if (layer->mode() == LayerBlendMode::Additive) {
+            if (!has_pose || !layer->sample_pose(skeleton, _layer_pose)) continue;
+            add_additive_pose(_pose, _layer_pose, layer->reference_pose(skeleton), weight, _pose, mask);
+            continue;
+        }
+
+        if (!has_pose) {
+            // The lowest layer playing anything starts from the rest pose
+            // (or is the pose, when it covers the whole skeleton)
+            if (!layer->sample_pose(skeleton, _layer_pose)) continue;
+            if (weight >= 1.0f && !mask) {
+                std::swap(_pose, _layer_pose);
+            } else {
+                _pose = skeleton.hierarchy->rest_pose;
+                blend_poses(_pose, _layer_pose, weight, _pose, mask);
+            }
+            has_pose = true;
+        } else if (layer->sample_pose(skeleton, _layer_pose)) {
+            blend_poses(_pose, _layer_pose, weight, _pose, mask);
+        }
+    }
+
+    if (has_pose) {
+        skeleton.apply_pose(_pose);
+    }
+}
+
+}  // namespace engine::pbr
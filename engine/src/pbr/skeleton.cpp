@@ -0,0 +1,126 @@
+#include <engine/pbr/skeleton.hpp>
+
+#include <cmath>
+#include <utility>
+
+namespace engine::pbr {
+
+namespace {
+
+/// Split a node transform into translation, rotation and scale (shear, which
+/// node transforms don't use, is lost)
+void decompose_transform(const glm::mat4& transform, glm::vec3& translation, glm::quat& rotation,
+                         glm::vec3& scale) {
+    translation = glm::vec3(transform[3]);
+
+    glm::vec3 axes[3] = {glm::vec3(transform[0]), glm::vec3(transform[1]), glm::vec3(transform[2])};
+    for (int i = 0; i < 3; ++i) {
+        scale[i] = glm::length(axes[i]);
+        if (scale[i] > 0.0f) axes[i] /= scale[i];
+    }
+
+    // A mirrored basis keeps a proper rotation and flips one scale axis
+    glm::mat3 basis(axes[0], axes[1], axes[2]);
+    if (glm::determinant(basis) < 0.0f) {
+        scale.x = -scale.x;
+        basis[0] = -basis[0];
+    }
+    rotation = glm::normalize(glm::quat_cast(basis));
+}
+
+}  // namespace
+
+int SkeletonHierarchy::find_node(const std::string& name) const {
+    for (size_t i = 0; i < names.size(); ++i) {
+        if (names[i] == name) return static_cast<int>(i);
+    }
+    return -1;
+}
+
+std::shared_ptr<SkeletonHierarchy> SkeletonHierarchy::build(
+    const SkeletonNode& root, const std::unordered_map<std::string, int>* bone_index_map)
+{
+    auto hierarchy = std::make_shared<SkeletonHierarchy>();
+
+    // Depth-first with an explicit stack (node, parent index); children are
+    // pushed in reverse so they come out in their original order
+    std::vector<std::pair<const SkeletonNode*, int>> stack;
+    stack.emplace_back(&root, -1);
+
+    while (!stack.empty()) {
+        auto [node, parent] = stack.back();
+        stack.pop_back();
+
+        int bone_index = -1;
+        if (bone_index_map) {
+            auto it = bone_index_map->find(node->name);
+            if (it != bone_index_map->end()) bone_index = it->second;
+        }
+
+        int index = static_cast<int>(hierarchy->parents.size());
+        hierarchy->names.push_back(node->name);
+        hierarchy->parents.push_back(parent);
+        hierarchy->local_transforms.push_back(node->transformation);
+        hierarchy->bone_indices.push_back(bone_index);
+
+        for (auto child = node->children.rbegin(); child != node->children.rend(); ++child) {
+            stack.emplace_back(&*child, index);
+        }
+    }
+
+    LocalPose& rest = hierarchy->rest_pose;
+    rest.resize(hierarchy->node_count());
+    for (size_t i = 0; i < hierarchy->node_count(); ++i) {
+        decompose_transform(hierarchy->local_transforms[i], rest.translations[i], rest.rotations[i],
+                            rest.scales[i]);
+    }
+
+    return hierarchy;
+}
+
+BoneMask BoneMask::subtree(const SkeletonHierarchy& hierarchy, const std::string& root_name, float weight) {
+    BoneMask mask;
+    mask.weights.assign(hierarchy.node_count(), 0.0f);
+
+    int root = hierarchy.find_node(root_name);
+    if (root < 0) return mask;
+
+    // Depth-first order keeps a subtree contiguous: it ends at the first node
+    // whose parent comes before the root
+    mask.weights[root] = weight;
+    for (size_t i = static_cast<size_t>(root) + 1;
+         i < hierarchy.node_count() && hierarchy.parents[i] >= root; ++i) {
+        mask.weights[i] = weight;
+    }
+    return mask;
+}
+
+BoneMask BoneMask::inverted() const {
+    BoneMask mask;
+    mask.weights.reserve(weights.size());
+    for (float weight : weights) {
+        mask.weights.push_back(1.0f - weight);
+    }
+    return mask;
+}
+
+void Skeleton::apply_pose(const LocalPose& pose) {
+    if (!hierarchy || !bindpose || pose.size() != hierarchy->node_count()) return;
+
+    const size_t node_count = hierarchy->node_count();
+    node_transforms.resize(node_count);
+
+    for (size_t i = 0; i < node_count; ++i) {
+        glm::mat4 local = compose_transform(pose.translations[i], pose.rotations[i], pose.scales[i]);
+
+        int parent = hierarchy->parents[i];
+        node_transforms[i] = parent >= 0 ? node_transforms[parent] * local : local;
+
+        int bone_index = hierarchy->bone_indices[i];
+        if (bone_index >= 0 && static_cast<size_t>(bone_index) < transforms.size()) {
+            transforms[bone_index] = node_transforms[i] * (*bindpose)[bone_index];
+        }
+    }
+}
+
+}  // namespace engine::pbr
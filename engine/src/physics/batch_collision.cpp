@@ -0,0 +1,174 @@
+#include <engine/physics/batch_collision.hpp>
+#include <engine/physics/simd.hpp>
+
+#include <algorithm>
+
+namespace engine::physics {
+
+namespace {
+
+// Append the lanes set in a comparison mask as indices first..first+WIDTH-1
+void append_lanes(int bits, size_t first, std::vector<uint32_t>& hits) {
+    for (int lane = 0; bits != 0; ++lane, bits >>= 1) {
+        if (bits & 1) hits.push_back(static_cast<uint32_t>(first + lane));
+    }
+}
+
+}  // namespace
+
+void SphereBatch::clear() {
+    center_x.clear();
+    center_y.clear();
+    center_z.clear();
+    radius.clear();
+}
+
+void SphereBatch::reserve(size_t count) {
+    center_x.reserve(count);
+    center_y.reserve(count);
+    center_z.reserve(count);
+    radius.reserve(count);
+}
+
+void SphereBatch::push_back(glm::vec3 center, float r) {
+    center_x.push_back(center.x);
+    center_y.push_back(center.y);
+    center_z.push_back(center.z);
+    radius.push_back(r);
+}
+
+void AABBBatch::clear() {
+    min_x.clear();
+    min_y.clear();
+    min_z.clear();
+    max_x.clear();
+    max_y.clear();
+    max_z.clear();
+}
+
+void AABBBatch::reserve(size_t count) {
+    min_x.reserve(count);
+    min_y.reserve(count);
+    min_z.reserve(count);
+    max_x.reserve(count);
+    max_y.reserve(count);
+    max_z.reserve(count);
+}
+
+void AABBBatch::push_back(const AABB& box) {
+    min_x.push_back(box.min.x);
+    min_y.push_back(box.min.y);
+    min_z.push_back(box.min.z);
+    max_x.push_back(box.max.x);
+    max_y.push_back(box.max.y);
+    max_z.push_back(box.max.z);
+}
+
+// The scalar tails below repeat the vector expressions operation for
+// operation, so a shape gets the same answer whichever lane it lands in.
+
+size_t overlap_sphere_spheres(glm::vec3 center, float radius, const SphereBatch& spheres,
+                              std::vector<uint32_t>& hits) {
+    hits.clear();
+    const size_t count = spheres.size();
+    const float* xs = spheres.center_x.data();
+    const float* ys = spheres.center_y.data();
+    const float* zs = spheres.center_z.data();
+    const float* rs = spheres.radius.data();
+
+    const simd::Float cx = simd::splat(center.x);
+    const simd::Float cy = simd::splat(center.y);
+    const simd::Float cz = simd::splat(center.z);
+    const simd::Float cr = simd::splat(radius);
+
+    size_t i = 0;
+    for (; i + simd::WIDTH <= count; i += simd::WIDTH) {
+        simd::Float dx = simd::load(xs + i) - cx;
+        simd::Float dy = simd::load(ys + i) - cy;
+        simd::Float dz = simd::load(zs + i) - cz;
+        simd::Float r = simd::load(rs + i) + cr;
+        int bits = simd::bits(dx * dx + dy * dy + dz * dz < r * r);
+        if (bits != 0) append_lanes(bits, i, hits);
+    }
+    for (; i < count; ++i) {
+        float dx = xs[i] - center.x;
+        float dy = ys[i] - center.y;
+        float dz = zs[i] - center.z;
+        float r = rs[i] + radius;
+        if (dx * dx + dy * dy + dz * dz < r * r) hits.push_back(static_cast<uint32_t>(i));
+    }
+    return hits.size();
+}
+
+size_t overlap_capsule_spheres(const CapsuleShape& capsule, glm::vec3 position,
+                               const SphereBatch& spheres, std::vector<uint32_t>& hits) {
+    hits.clear();
+    const size_t count = spheres.size();
+    const float* xs = spheres.center_x.data();
+    const float* ys = spheres.center_y.data();
+    const float* zs = spheres.center_z.data();
+    const float* rs = spheres.radius.data();
+
+    // Distance to the capsule's vertical segment: the vertical offset is
+    // clamped to the segment, the horizontal one is used as is
+    const glm::vec3 center = position + capsule.offset;
+    const float half_height = std::max(capsule.half_cylinder_height(), 0.0f);
+
+    const simd::Float cx = simd::splat(center.x);
+    const simd::Float cy = simd::splat(center.y);
+    const simd::Float cz = simd::splat(center.z);
+    const simd::Float cr = simd::splat(capsule.radius);
+    const simd::Float top = simd::splat(half_height);
+    const simd::Float bottom = simd::splat(-half_height);
+
+    size_t i = 0;
+    for (; i + simd::WIDTH <= count; i += simd::WIDTH) {
+        simd::Float dx = simd::load(xs + i) - cx;
+        simd::Float dy = simd::load(ys + i) - cy;
+        simd::Float dz = simd::load(zs + i) - cz;
+        dy = dy - simd::min(simd::max(dy, bottom), top);
+        simd::Float r = simd::load(rs + i) + cr;
+        int bits = simd::bits(dx * dx + dy * dy + dz * dz < r * r);
+        if (bits != 0) append_lanes(bits, i, hits);
+    }
+    for (; i < count; ++i) {
+        float dx = xs[i] - center.x;
+        float dy = ys[i] - center.y;
+        float dz = zs[i] - center.z;
+        dy = dy - std::min(std::max(dy, -half_height), half_height);
+        float r = rs[i] + capsule.radius;
+        if (dx * dx + dy * dy + dz * dz < r * r) hits.push_back(static_cast<uint32_t>(i));
+    }
+    return hits.size();
+}
+
+size_t overlap_aabb_aabbs(const AABB& box, const AABBBatch& boxes, std::vector<uint32_t>& hits) {
+    hits.clear();
+    const size_t count = boxes.size();
+
+    const simd::Float lo_x = simd::splat(box.min.x);
+    const simd::Float lo_y = simd::splat(box.min.y);
+    const simd::Float lo_z = simd::splat(box.min.z);
+    const simd::Float hi_x = simd::splat(box.max.x);
+    const simd::Float hi_y = simd::splat(box.max.y);
+    const simd::Float hi_z = simd::splat(box.max.z);
+
+    size_t i = 0;
+    for (; i + simd::WIDTH <= count; i += simd::WIDTH) {
+        simd::Mask overlap = (lo_x <= simd::load(&boxes.max_x[i])) & (simd::load(&boxes.min_x[i]) <= hi_x) &
+                             (lo_y <= simd::load(&boxes.max_y[i])) & (simd::load(&boxes.min_y[i]) <= hi_y) &
+                             (lo_z <= simd::load(&boxes.max_z[i])) & (simd::load(&boxes.min_z[i]) <= hi_z);
+        int bits = simd::bits(overlap);
+        if (bits != 0) append_lanes(bits, i, hits);
+    }
+    for (; i < count; ++i) {
+        if (box.min.x <= boxes.max_x[i] && boxes.min_x[i] <= box.max.x &&
+            box.min.y <= boxes.max_y[i] && boxes.min_y[i] <= box.max.y &&
+            box.min.z <= boxes.max_z[i] && boxes.min_z[i] <= box.max.z) {
+            hits.push_back(static_cast<uint32_t>(i));
+        }
+    }
+    return hits.size();
+}
+
+}  // namespace engine::physics
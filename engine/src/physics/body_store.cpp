@@ -0,0 +1,220 @@
+#include <engine/physics/body_store.hpp>
+#include <engine/physics/dynamic_aabb_tree.hpp>
+#include <engine/physics/simd.hpp>
+
+namespace engine::physics {
+
+namespace {
+
+template <typename T>
+void swap_remove(std::vector<T>& column, uint32_t index) {
+    column[index] = column.back();
+    column.pop_back();
+}
+
+}  // namespace
+
+BodyHandle BodyStore::create(const BodyState& state, RigidBody* owner) {
+    uint32_t slot;
+    if (!_free_slots.empty()) {
+        slot = _free_slots.back();
+        _free_slots.pop_back();
+    } else {
+        slot = static_cast<uint32_t>(_slots.size());
+        _slots.push_back(Slot{});
+    }
+
+    uint32_t index = static_cast<uint32_t>(owners.size());
+    _slots[slot].dense = index;
+
+    pos_x.push_back(0.0f); pos_y.push_back(0.0f); pos_z.push_back(0.0f);
+    prev_x.push_back(state.position.x); prev_y.push_back(state.position.y); prev_z.push_back(state.position.z);
+    vel_x.push_back(0.0f); vel_y.push_back(0.0f); vel_z.push_back(0.0f);
+    force_x.push_back(0.0f); force_y.push_back(0.0f); force_z.push_back(0.0f);
+    mass.push_back(0.0f);
+    inv_mass.push_back(0.0f);
+    drag.push_back(0.0f);
+    restitution.push_back(0.0f);
+    gravity_scale.push_back(0.0f);
+    motion_scale.push_back(0.0f);
+    sleep_time.push_back(0.0f);
+    flags.push_back(0);
+    collision_layers.push_back(0);
+    collision_masks.push_back(0);
+    shapes.push_back(state.shape);
+    owners.push_back(owner);
+    tree_proxies.push_back(DynamicAABBTree::NULL_NODE);
+    slots.push_back(slot);
+
+    set_state(index, state);
+
+    return BodyHandle{slot, _slots[slot].generation};
+}
+
+BodyState BodyStore::destroy(BodyHandle handle) {
+    uint32_t index = dense_index(handle);
+    BodyState state = get_state(index);
+
+    // Move the last body into the hole and repoint its slot
+    uint32_t last_slot = slots.back();
+    _slots[last_slot].dense = index;
+
+    swap_remove(pos_x, index); swap_remove(pos_y, index); swap_remove(pos_z, index);
+    swap_remove(prev_x, index); swap_remove(prev_y, index); swap_remove(prev_z, index);
+    swap_remove(vel_x, index); swap_remove(vel_y, index); swap_remove(vel_z, index);
+    swap_remove(force_x, index); swap_remove(force_y, index); swap_remove(force_z, index);
+    swap_remove(mass, index);
+    swap_remove(inv_mass, index);
+    swap_remove(drag, index);
+    swap_remove(restitution, index);
+    swap_remove(gravity_scale, index);
+    swap_remove(motion_scale, index);
+    swap_remove(sleep_time, index);
+    swap_remove(flags, index);
+    swap_remove(collision_layers, index);
+    swap_remove(collision_masks, index);
+    swap_remove(shapes, index);
+    swap_remove(owners, index);
+    swap_remove(tree_proxies, index);
+    swap_remove(slots, index);
+
+    ++_slots[handle.slot].generation;
+    _free_slots.push_back(handle.slot);
+
+    return state;
+}
+
+void BodyStore::clear() {
+    pos_x.clear(); pos_y.clear(); pos_z.clear();
+    prev_x.clear(); prev_y.clear(); prev_z.clear();
+    vel_x.clear(); vel_y.clear(); vel_z.clear();
+    force_x.clear(); force_y.clear(); force_z.clear();
+    mass.clear();
+    inv_mass.clear();
+    drag.clear();
+    restitution.clear();
+    gravity_scale.clear();
+    motion_scale.clear();
+    sleep_time.clear();
+    flags.clear();
+    collision_layers.clear();
+    collision_masks.clear();
+    shapes.clear();
+    owners.clear();
+    tree_proxies.clear();
+    slots.clear();
+
+    // Invalidate every outstanding handle
+    _free_slots.clear();
+    for (uint32_t slot = 0; slot < _slots.size(); ++slot) {
+        ++_slots[slot].generation;
+        _free_slots.push_back(slot);
+    }
+}
+
+bool BodyStore::contains(BodyHandle handle) const {
+    if (!handle.valid() || handle.slot >= _slots.size()) return false;
+    const Slot& slot = _slots[handle.slot];
+    return slot.generation == handle.generation && slot.dense < slots.size() &&
+           slots[slot.dense] == handle.slot;
+}
+
+BodyState BodyStore::get_state(uint32_t index) const {
+    BodyState state;
+    state.position = position(index);
+    state.velocity = velocity(index);
+    state.force = force(index);
+    state.mass = mass[index];
+    state.inv_mass = inv_mass[index];
+    state.drag = drag[index];
+    state.restitution = restitution[index];
+    state.flags = flags[index];
+    state.collision_layer = collision_layers[index];
+    state.collision_mask = collision_masks[index];
+    state.shape = shapes[index];
+    return state;
+}
+
+void BodyStore::set_state(uint32_t index, const BodyState& state) {
+    set_position(index, state.position);
+    set_velocity(index, state.velocity);
+    set_force(index, state.force);
+    mass[index] = state.mass;
+    inv_mass[index] = state.inv_mass;
+    drag[index] = state.drag;
+    restitution[index] = state.restitution;
+    set_flags(index, state.flags);
+    collision_layers[index] = state.collision_layer;
+    collision_masks[index] = state.collision_mask;
+    shapes[index] = state.shape;
+}
+
+void BodyStore::set_flags(uint32_t index, uint32_t new_flags) {
+    flags[index] = new_flags;
+
+    // Sleeping bodies integrate like static ones (no motion, no gravity)
+    bool moving = (new_flags & (BODY_STATIC | BODY_SLEEPING)) == 0;
+    motion_scale[index] = moving ? 1.0f : 0.0f;
+    gravity_scale[index] = moving && (new_flags & BODY_USE_GRAVITY) ? 1.0f : 0.0f;
+}
+
+void BodyStore::integrate(float delta, glm::vec3 gravity) {
+    // Static and sleeping bodies have motion_scale 0, so the update below
+    // leaves their position and velocity untouched without a branch:
+    //   v = (v + g * gravity_scale * dt + F * inv_mass * dt) * (1 - drag * dt * motion)
+    //   p = p + v * dt * motion
+    const uint32_t count = static_cast<uint32_t>(size());
+    uint32_t i = 0;
+
+    const simd::Float dt = simd::splat(delta);
+    const simd::Float one = simd::splat(1.0f);
+    const simd::Float zero = simd::splat(0.0f);
+    const simd::Float gdt_x = simd::splat(gravity.x * delta);
+    const simd::Float gdt_y = simd::splat(gravity.y * delta);
+    const simd::Float gdt_z = simd::splat(gravity.z * delta);
+
+    for (; i + simd::WIDTH <= count; i += simd::WIDTH) {
+        simd::Float gs = simd::load(&gravity_scale[i]);
+        simd::Float ms = simd::load(&motion_scale[i]);
+        simd::Float im_dt = simd::load(&inv_mass[i]) * dt;
+        simd::Float damping = one - simd::load(&drag[i]) * dt * ms;
+        simd::Float move_dt = dt * ms;
+
+        simd::Float vx = (simd::load(&vel_x[i]) + gdt_x * gs + simd::load(&force_x[i]) * im_dt) * damping;
+        simd::Float vy = (simd::load(&vel_y[i]) + gdt_y * gs + simd::load(&force_y[i]) * im_dt) * damping;
+        simd::Float vz = (simd::load(&vel_z[i]) + gdt_z * gs + simd::load(&force_z[i]) * im_dt) * damping;
+
+        simd::store(&vel_x[i], vx);
+        simd::store(&vel_y[i], vy);
+        simd::store(&vel_z[i], vz);
+        simd::store(&pos_x[i], simd::load(&pos_x[i]) + vx * move_dt);
+        simd::store(&pos_y[i], simd::load(&pos_y[i]) + vy * move_dt);
+        simd::store(&pos_z[i], simd::load(&pos_z[i]) + vz * move_dt);
+        simd::store(&force_x[i], zero);
+        simd::store(&force_y[i], zero);
+        simd::store(&force_z[i], zero);
+    }
+
+    // Scalar tail (same operation order as the vector loop)
+    for (; i < count; ++i) {
+        float gs = gravity_scale[i];
+        float ms = motion_scale[i];
+        float im_dt = inv_mass[i] * delta;
+        float damping = 1.0f - drag[i] * delta * ms;
+        float move_dt = delta * ms;
+
+        vel_x[i] = (vel_x[i] + gravity.x * delta * gs + force_x[i] * im_dt) * damping;
+        vel_y[i] = (vel_y[i] + gravity.y * delta * gs + force_y[i] * im_dt) * damping;
+        vel_z[i] = (vel_z[i] + gravity.z * delta * gs + force_z[i] * im_dt) * damping;
+
+        pos_x[i] += vel_x[i] * move_dt;
+        pos_y[i] += vel_y[i] * move_dt;
+        pos_z[i] += vel_z[i] * move_dt;
+
+        force_x[i] = 0.0f;
+        force_y[i] = 0.0f;
+        force_z[i] = 0.0f;
+    }
+}
+
+}  // namespace engine::physics
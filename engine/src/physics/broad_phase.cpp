@@ -0,0 +1,31 @@
+#include <engine/physics/broad_phase.hpp>
+#include <engine/physics/spatial_hash_broad_phase.hpp>
+#include <engine/physics/sweep_and_prune_broad_phase.hpp>
+
+namespace engine::physics {
+
+void BruteForceBroadPhase::find_pairs(const std::vector<BroadPhaseProxy>& proxies,
+                                      std::vector<BodyPair>& out_pairs) {
+    uint32_t count = static_cast<uint32_t>(proxies.size());
+    for (uint32_t i = 0; i < count; ++i) {
+        for (uint32_t j = i + 1; j < count; ++j) {
+            if (!should_test_pair(proxies[i], proxies[j])) continue;
+            if (!proxies[i].bounds.overlaps(proxies[j].bounds)) continue;
+            out_pairs.push_back({i, j});
+        }
+    }
+}
+
+std::unique_ptr<BroadPhase> create_broad_phase(BroadPhaseType type) {
+    switch (type) {
+        case BroadPhaseType::BruteForce:
+            return std::make_unique<BruteForceBroadPhase>();
+        case BroadPhaseType::SpatialHash:
+            return std::make_unique<SpatialHashBroadPhase>();
+        case BroadPhaseType::SweepAndPrune:
+            return std::make_unique<SweepAndPruneBroadPhase>();
+    }
+    return std::make_unique<SpatialHashBroadPhase>();
+}
+
+}  // namespace engine::physics
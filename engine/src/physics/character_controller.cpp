@@ -0,0 +1,357 @@
+#include <engine/physics/character_controller.hpp>
+#include <engine/physics/collision.hpp>
+#include <engine/physics/physics_world.hpp>
+
+#include <algorithm>
+#include <cmath>
+
+namespace engine::physics {
+
+thread_local CharacterController::Batch CharacterController::s_batch;
+
+namespace {
+
+// Depenetration passes over the candidates at the start of a move
+constexpr int DEPENETRATION_ITERATIONS = 2;
+
+// How far past a ledge edge (and above it) the surface under it is checked
+constexpr float EDGE_PROBE_OFFSET = 0.02f;
+
+float horizontal_length_sq(glm::vec3 v) {
+    return v.x * v.x + v.z * v.z;
+}
+
+}  // namespace
+
+CharacterController::CharacterController(const CharacterSettings& settings)
+    : _settings(settings) {}
+
+void CharacterController::add_to_world(PhysicsWorld& world) {
+    if (_body.world()) return;
+
+    _body.set_shape(capsule());
+    _body.set_static(true);
+    _body.set_use_gravity(false);
+    _body.set_position(_position);
+    world.add_body(&_body);
+}
+
+void CharacterController::remove_from_world() {
+    if (PhysicsWorld* world = _body.world()) {
+        world->remove_body(&_body);
+    }
+}
+
+void CharacterController::set_settings(const CharacterSettings& settings) {
+    _settings = settings;
+    _body.set_shape(capsule());
+}
+
+void CharacterController::set_position(glm::vec3 position) {
+    _position = position;
+    _velocity = glm::vec3(0.0f);
+    _vertical_speed = 0.0f;
+    _grounded = false;
+    _body.set_position(position);
+}
+
+void CharacterController::jump(float speed) {
+    if (!_grounded) return;
+    _vertical_speed = speed;
+    _grounded = false;
+}
+
+void CharacterController::move(PhysicsWorld& world, float delta) {
+    if (delta <= 0.0f) return;
+
+    Move motion = begin_move(world.gravity().y, delta);
+    world.query_candidates(candidate_bounds(motion.horizontal + motion.vertical), _candidates,
+                           _settings.collision_mask);
+    filter_candidates(world, _candidates);
+    finish_move(world, _candidates, motion, delta);
+}
+
+void CharacterController::move_all(PhysicsWorld& world, CharacterController* const* controllers,
+                                   size_t count, float delta) {
+    if (count == 0 || delta <= 0.0f) return;
+
+    // Every capsule is queried up front, before any of them moves;
+    // CANDIDATE_MARGIN covers the characters that move in between
+    Batch& batch = s_batch;
+    batch.moves.resize(count);
+    batch.bounds.resize(count);
+    batch.masks.resize(count);
+
+    float gravity = world.gravity().y;
+    for (size_t i = 0; i < count; ++i) {
+        CharacterController& controller = *controllers[i];
+        batch.moves[i] = controller.begin_move(gravity, delta);
+        batch.bounds[i] = controller.candidate_bounds(batch.moves[i].horizontal + batch.moves[i].vertical);
+        batch.masks[i] = controller._settings.collision_mask;
+    }
+
+    world.query_candidates_many(batch.bounds.data(), batch.masks.data(), static_cast<uint32_t>(count),
+                                batch.offsets, batch.indices);
+
+    for (size_t i = 0; i < count; ++i) {
+        CharacterController& controller = *controllers[i];
+        controller._candidates.assign(batch.indices.begin() + batch.offsets[i],
+                                      batch.indices.begin() + batch.offsets[i + 1]);
+        controller.filter_candidates(world, controller._candidates);
+        controller.finish_move(world, controller._candidates, batch.moves[i], delta);
+    }
+}
+
+CapsuleShape CharacterController::capsule() const {
+    float height = std::max(_settings.height, 2.0f * _settings.radius);
+    return CapsuleShape(_settings.radius, height, glm::vec3(0.0f, height * 0.5f, 0.0f));
+}
+
+CharacterController::Move CharacterController::begin_move(float gravity, float delta) {
+    Move motion;
+    motion.was_grounded = _grounded;
+    if (motion.was_grounded) {
+        _vertical_speed = std::max(_vertical_speed, 0.0f);
+    } else {
+        _vertical_speed += gravity * delta;
+    }
+
+    motion.horizontal = glm::vec3(_desired_velocity.x * delta, 0.0f, _desired_velocity.z * delta);
+    motion.vertical = glm::vec3(0.0f, _vertical_speed * delta, 0.0f);
+    return motion;
+}
+
+AABB CharacterController::candidate_bounds(glm::vec3 motion) const {
+    // Everything the capsule can reach this move: the motion itself, a step
+    // up, the ground probe below, plus the margin for stale tree bounds
+    CollisionShape shape = capsule();
+    AABB bounds = compute_aabb(shape, _position).merged(compute_aabb(shape, _position + motion));
+    float vertical = _settings.step_height + _settings.ground_probe + _settings.skin_width;
+    glm::vec3 reach(CANDIDATE_MARGIN, CANDIDATE_MARGIN + vertical, CANDIDATE_MARGIN);
+    return AABB(bounds.min - reach, bounds.max + reach);
+}
+
+void CharacterController::filter_candidates(const PhysicsWorld& world, std::vector<uint32_t>& candidates) const {
+    // Skip our own capsule and triggers (they never block)
+    const BodyStore& store = world.body_store();
+    candidates.erase(std::remove_if(candidates.begin(), candidates.end(), [&](uint32_t index) {
+        return store.owners[index] == &_body || store.is_trigger(index) || store.shapes[index].empty();
+    }), candidates.end());
+}
+
+void CharacterController::finish_move(const PhysicsWorld& world, const std::vector<uint32_t>& candidates,
+                                      const Move& motion, float delta) {
+    const glm::vec3& horizontal = motion.horizontal;
+    const glm::vec3& vertical = motion.vertical;
+    bool was_grounded = motion.was_grounded;
+
+    glm::vec3 start = depenetrate(world, candidates, _position);
+
+    // Horizontal: slide, and when a wall low enough to step over is in the
+    // way while on the ground, also try the same move lifted by step_height;
+    // keep whichever gets further
+    glm::vec3 position = start;
+    Hit wall;
+    bool blocked = slide(world, candidates, position, horizontal, was_grounded, wall);
+    if (blocked && was_grounded && _settings.step_height > 0.0f &&
+        wall.point.y <= start.y + _settings.step_height) {
+        Hit hit;
+        glm::vec3 lift(0.0f, _settings.step_height, 0.0f);
+        float rise = _settings.step_height;
+        if (sweep(world, candidates, start, lift, hit)) {
+            rise = std::max(hit.time * _settings.step_height - _settings.skin_width, 0.0f);
+        }
+
+        glm::vec3 stepped = start + glm::vec3(0.0f, rise, 0.0f);
+        slide(world, candidates, stepped, horizontal, true, hit);
+
+        // Only if it lands on something no higher than a step
+        glm::vec3 ground;
+        if (probe_ground(world, candidates, stepped, rise + _settings.ground_probe, ground, hit) &&
+            hit.point.y <= start.y + _settings.step_height + _settings.skin_width &&
+            horizontal_length_sq(ground - start) > horizontal_length_sq(position - start) + 1e-8f) {
+            position = ground;
+        }
+    }
+
+    // Vertical: fall (or rise) until something is in the way
+    if (vertical.y != 0.0f && slide(world, candidates, position, vertical, false, wall) && vertical.y > 0.0f) {
+        _vertical_speed = 0.0f;  // Hit the ceiling (or a steep overhang)
+    }
+
+    // Ground: within the probe distance, or within a step when it was on the
+    // ground before (follows slopes and steps down instead of hopping off)
+    _grounded = false;
+    _ground_normal = glm::vec3(0.0f, 1.0f, 0.0f);
+    if (_vertical_speed <= 0.0f) {
+        float distance = _settings.ground_probe + (was_grounded ? _settings.step_height : 0.0f);
+        glm::vec3 ground;
+        Hit ground_hit;
+        if (probe_ground(world, candidates, position, distance, ground, ground_hit)) {
+            position = ground;
+            _grounded = true;
+            _ground_normal = ground_hit.normal;
+            _vertical_speed = 0.0f;
+        }
+    }
+
+    _velocity = (position - _position) / delta;
+    _position = position;
+    _body.set_position(position);
+}
+
+glm::vec3 CharacterController::depenetrate(const PhysicsWorld& world, const std::vector<uint32_t>& candidates,
+                                           glm::vec3 position) const {
+    // Push out of anything the capsule starts inside (spawned into another
+    // character, or a body moved onto it), a few passes at most
+    const BodyStore& store = world.body_store();
+    CollisionShape shape = capsule();
+
+    for (int iteration = 0; iteration < DEPENETRATION_ITERATIONS; ++iteration) {
+        bool moved = false;
+        for (uint32_t index : candidates) {
+            auto result = test_collision(shape, position, store.shapes[index], store.position(index));
+            if (!result.collided) continue;
+
+            position -= result.normal * (result.penetration + _settings.skin_width);
+            moved = true;
+        }
+        if (!moved) break;
+    }
+    return position;
+}
+
+bool CharacterController::sweep(const PhysicsWorld& world, const std::vector<uint32_t>& candidates,
+                                glm::vec3 start, glm::vec3 motion, Hit& hit) const {
+    float length = glm::length(motion);
+    if (length < 1e-6f) return false;
+
+    const BodyStore& store = world.body_store();
+    CapsuleShape shape = capsule();
+    AABB swept = compute_aabb(shape, start).merged(compute_aabb(shape, start + motion));
+    bool found = false;
+
+    for (uint32_t index : candidates) {
+        if (!compute_aabb(store.shapes[index], store.position(index)).overlaps(swept)) continue;
+
+        auto result = sweep_capsule(shape, start, motion, store.shapes[index], store.position(index));
+        if (!result.hit || (found && result.time >= hit.time)) continue;
+
+        // Touching at the start but moving away or along the surface
+        if (result.time <= 0.0f && glm::dot(result.normal, motion) > -1e-3f * length) continue;
+
+        hit.time = result.time;
+        hit.point = result.contact_point;
+        hit.normal = result.normal;
+        found = true;
+    }
+    return found;
+}
+
+bool CharacterController::slide(const PhysicsWorld& world, const std::vector<uint32_t>& candidates,
+                                glm::vec3& position, glm::vec3 motion, bool walking, Hit& wall) const {
+    bool blocked = false;
+    glm::vec3 original = motion;
+    glm::vec3 previous_normal(0.0f);
+
+    for (int iteration = 0; iteration < _settings.max_slide_iterations; ++iteration) {
+        float length = glm::length(motion);
+        if (length < 1e-5f) break;
+
+        Hit hit;
+        if (!sweep(world, candidates, position, motion, hit)) {
+            position += motion;
+            break;
+        }
+
+        // Stop short of the contact by the skin width
+        glm::vec3 direction = motion / length;
+        float travel = std::max(hit.time * length - _settings.skin_width, 0.0f);
+        position += direction * travel;
+
+        glm::vec3 normal = hit.normal;
+        if (!is_walkable(normal)) {
+            if (!blocked) wall = hit;
+            blocked = true;
+
+            if (walking) {
+                // Walls neither lift a walking character nor push it down
+                normal.y = 0.0f;
+                if (glm::dot(normal, normal) < 1e-8f) break;
+                normal = glm::normalize(normal);
+            }
+        } else if (!walking) {
+            break;  // Landed
+        }
+
+        // Slide the rest of the motion along the surface (walking up a slope
+        // keeps the horizontal motion); in a crease between two surfaces,
+        // along the crease line
+        glm::vec3 remaining = direction * (length - travel);
+        if (walking && is_walkable(normal)) {
+            motion = remaining;
+            motion.y = -(remaining.x * normal.x + remaining.z * normal.z) / normal.y;
+        } else {
+            motion = remaining - normal * glm::dot(remaining, normal);
+        }
+        if (iteration > 0 && glm::dot(motion, previous_normal) < 0.0f) {
+            glm::vec3 crease = glm::cross(previous_normal, normal);
+            float crease_length = glm::length(crease);
+            if (crease_length < 1e-4f) break;
+            crease /= crease_length;
+            motion = crease * glm::dot(remaining, crease);
+        }
+        previous_normal = normal;
+
+        // Never turn back against the requested motion (jitter in corners)
+        if (glm::dot(motion, original) <= 0.0f) break;
+    }
+    return blocked;
+}
+
+bool CharacterController::probe_ground(const PhysicsWorld& world, const std::vector<uint32_t>& candidates,
+                                       glm::vec3 start, float distance, glm::vec3& ground, Hit& hit) const {
+    if (!sweep(world, candidates, start, glm::vec3(0.0f, -distance, 0.0f), hit)) return false;
+
+    float travel = std::max(hit.time * distance - _settings.skin_width, 0.0f);
+    ground = start + glm::vec3(0.0f, -travel, 0.0f);
+    if (is_walkable(hit.normal)) return true;
+
+    // Resting on an edge (a ledge, the lip of a step) gives a slanted contact
+    // normal: judge by the surface just past the edge instead
+    glm::vec3 outward = hit.point - (start + capsule().offset);
+    outward.y = 0.0f;
+    if (glm::dot(outward, outward) > 1e-8f) {
+        glm::vec3 origin = hit.point + glm::normalize(outward) * EDGE_PROBE_OFFSET +
+                           glm::vec3(0.0f, EDGE_PROBE_OFFSET, 0.0f);
+        if (surface_below(world, candidates, origin, 2.0f * EDGE_PROBE_OFFSET, hit.normal)) return true;
+    }
+
+    // Wedged against a steep slope with the ground right under the feet
+    glm::vec3 feet = start + glm::vec3(0.0f, EDGE_PROBE_OFFSET, 0.0f);
+    if (surface_below(world, candidates, feet, 2.0f * EDGE_PROBE_OFFSET + _settings.skin_width, hit.normal)) {
+        ground = start;
+        hit.point = start;
+        return true;
+    }
+    return false;
+}
+
+bool CharacterController::surface_below(const PhysicsWorld& world, const std::vector<uint32_t>& candidates,
+                                        glm::vec3 origin, float max_dist, glm::vec3& normal) const {
+    // Closest surface straight down, if it's walkable
+    const BodyStore& store = world.body_store();
+    glm::vec3 down(0.0f, -1.0f, 0.0f);
+    bool found = false;
+    for (uint32_t index : candidates) {
+        auto result = raycast_shape(origin, down, max_dist, store.shapes[index], store.position(index));
+        if (result.hit) {
+            max_dist = result.distance;
+            normal = result.normal;
+            found = true;
+        }
+    }
+    return found && is_walkable(normal);
+}
+
+}  // namespace engine::physics
@@ -1,9 +1,12 @@
 #include <engine/physics/collision.hpp>
+#include <engine/physics/height_field.hpp>
+#include <engine/physics/triangle_mesh.hpp>
 
 #include <glm/gtc/constants.hpp>
 
 #include <algorithm>
 #include <cmath>
+#include <limits>
 
 namespace engine::physics {
 
@@ -89,6 +92,195 @@ static void closest_points_segments(
     closest_b = b1 + t * d2;
 }
 
+// Helper: Entry time of the ray origin + t * motion (t in [0, t_max]) into a
+// sphere. A start inside the sphere counts as a hit at t = 0.
+static bool intersect_ray_sphere(glm::vec3 origin, glm::vec3 motion, float t_max,
+                                 glm::vec3 center, float radius, float& t) {
+    glm::vec3 m = origin - center;
+    float c = glm::dot(m, m) - radius * radius;
+    if (c <= 0.0f) {
+        t = 0.0f;
+        return true;
+    }
+
+    float a = glm::dot(motion, motion);
+    float b = glm::dot(m, motion);
+    if (a < 1e-12f || b >= 0.0f) return false;  // Not moving, or moving away
+
+    float discriminant = b * b - a * c;
+    if (discriminant < 0.0f) return false;
+
+    t = (-b - std::sqrt(discriminant)) / a;
+    return t <= t_max;
+}
+
+// Helper: Entry time of a ray into a capsule around seg_start-seg_end
+static bool intersect_ray_capsule(glm::vec3 origin, glm::vec3 motion, float t_max,
+                                  glm::vec3 seg_start, glm::vec3 seg_end,
+                                  float radius, float& t) {
+    glm::vec3 axis = seg_end - seg_start;
+    float dd = glm::dot(axis, axis);
+    if (dd < 1e-12f) {
+        return intersect_ray_sphere(origin, motion, t_max, seg_start, radius, t);
+    }
+
+    glm::vec3 closest = closest_point_on_segment(origin, seg_start, seg_end);
+    if (glm::dot(origin - closest, origin - closest) <= radius * radius) {
+        t = 0.0f;
+        return true;
+    }
+
+    float best = std::numeric_limits<float>::infinity();
+
+    // Infinite cylinder, accepted only within the segment's extent
+    glm::vec3 m = origin - seg_start;
+    float md = glm::dot(m, axis);
+    float nd = glm::dot(motion, axis);
+    float nn = glm::dot(motion, motion);
+    float a = dd * nn - nd * nd;
+    if (a > 1e-12f) {
+        float b = dd * glm::dot(m, motion) - nd * md;
+        float c = dd * (glm::dot(m, m) - radius * radius) - md * md;
+        float discriminant = b * b - a * c;
+        if (discriminant >= 0.0f) {
+            float tc = (-b - std::sqrt(discriminant)) / a;
+            float s = md + tc * nd;
+            if (tc >= 0.0f && tc <= t_max && s >= 0.0f && s <= dd) {
+                best = tc;
+            }
+        }
+    }
+
+    // Hemispherical caps
+    float ts;
+    if (intersect_ray_sphere(origin, motion, t_max, seg_start, radius, ts)) best = std::min(best, ts);
+    if (intersect_ray_sphere(origin, motion, t_max, seg_end, radius, ts)) best = std::min(best, ts);
+
+    if (best > t_max) return false;
+    t = best;
+    return true;
+}
+
+// Helper: Entry time of a ray into a box (slab test). A start inside the
+// box counts as a hit at t = 0.
+static bool intersect_ray_box(glm::vec3 origin, glm::vec3 motion, float t_max,
+                              glm::vec3 box_min, glm::vec3 box_max, float& t) {
+    float t_min = 0.0f;
+
+    for (int axis = 0; axis < 3; ++axis) {
+        if (std::abs(motion[axis]) < 1e-12f) {
+            if (origin[axis] < box_min[axis] || origin[axis] > box_max[axis]) return false;
+            continue;
+        }
+
+        float inv = 1.0f / motion[axis];
+        float t1 = (box_min[axis] - origin[axis]) * inv;
+        float t2 = (box_max[axis] - origin[axis]) * inv;
+        if (t1 > t2) std::swap(t1, t2);
+
+        t_min = std::max(t_min, t1);
+        t_max = std::min(t_max, t2);
+        if (t_min > t_max) return false;
+    }
+
+    t = t_min;
+    return true;
+}
+
+// Helper: Outward normal of the box face nearest to a point on or in it
+static glm::vec3 aabb_face_normal(glm::vec3 point, glm::vec3 aabb_center, glm::vec3 half_extents) {
+    glm::vec3 local = (point - aabb_center) / glm::max(half_extents, glm::vec3(1e-6f));
+    glm::vec3 a = glm::abs(local);
+
+    if (a.x >= a.y && a.x >= a.z) return glm::vec3(local.x >= 0 ? 1.0f : -1.0f, 0.0f, 0.0f);
+    if (a.y >= a.z) return glm::vec3(0.0f, local.y >= 0 ? 1.0f : -1.0f, 0.0f);
+    return glm::vec3(0.0f, 0.0f, local.z >= 0 ? 1.0f : -1.0f);
+}
+
+// Helper: Normal from a surface point towards the swept center, falling back
+// to facing the motion when the two coincide (zero radius, or starting inside)
+static glm::vec3 sweep_normal(glm::vec3 center, glm::vec3 surface_point, glm::vec3 motion) {
+    glm::vec3 delta = center - surface_point;
+    float length = glm::length(delta);
+    if (length > 1e-6f) return delta / length;
+
+    float motion_length = glm::length(motion);
+    if (motion_length > 1e-6f) return -motion / motion_length;
+    return glm::vec3(0.0f, 1.0f, 0.0f);
+}
+
+// Helper: Closest point on a triangle to a point (by Voronoi region)
+static glm::vec3 closest_point_on_triangle(glm::vec3 p, const Triangle& tri) {
+    glm::vec3 ab = tri.b - tri.a;
+    glm::vec3 ac = tri.c - tri.a;
+    glm::vec3 ap = p - tri.a;
+
+    float d1 = glm::dot(ab, ap);
+    float d2 = glm::dot(ac, ap);
+    if (d1 <= 0.0f && d2 <= 0.0f) return tri.a;
+
+    glm::vec3 bp = p - tri.b;
+    float d3 = glm::dot(ab, bp);
+    float d4 = glm::dot(ac, bp);
+    if (d3 >= 0.0f && d4 <= d3) return tri.b;
+
+    float vc = d1 * d4 - d3 * d2;
+    if (vc <= 0.0f && d1 >= 0.0f && d3 <= 0.0f) {
+        return tri.a + ab * (d1 / (d1 - d3));
+    }
+
+    glm::vec3 cp = p - tri.c;
+    float d5 = glm::dot(ab, cp);
+    float d6 = glm::dot(ac, cp);
+    if (d6 >= 0.0f && d5 <= d6) return tri.c;
+
+    float vb = d5 * d2 - d1 * d6;
+    if (vb <= 0.0f && d2 >= 0.0f && d6 <= 0.0f) {
+        return tri.a + ac * (d2 / (d2 - d6));
+    }
+
+    float va = d3 * d6 - d5 * d4;
+    if (va <= 0.0f && (d4 - d3) >= 0.0f && (d5 - d6) >= 0.0f) {
+        return tri.b + (tri.c - tri.b) * ((d4 - d3) / ((d4 - d3) + (d5 - d6)));
+    }
+
+    float denom = 1.0f / (va + vb + vc);
+    return tri.a + ab * (vb * denom) + ac * (vc * denom);
+}
+
+// Helper: Whether a point in the triangle's plane lies inside it
+static bool point_in_triangle(glm::vec3 p, const Triangle& tri, glm::vec3 normal) {
+    return glm::dot(glm::cross(tri.b - tri.a, p - tri.a), normal) >= 0.0f &&
+           glm::dot(glm::cross(tri.c - tri.b, p - tri.b), normal) >= 0.0f &&
+           glm::dot(glm::cross(tri.a - tri.c, p - tri.c), normal) >= 0.0f;
+}
+
+// Helper: Closest points between a segment and a triangle, for a segment that
+// doesn't cross the triangle (closest of the two end points and three edges)
+static void closest_points_segment_triangle(glm::vec3 seg_start, glm::vec3 seg_end, const Triangle& tri,
+                                            glm::vec3& on_segment, glm::vec3& on_triangle) {
+    float best_dist_sq = std::numeric_limits<float>::max();
+    auto consider = [&](glm::vec3 segment_point, glm::vec3 triangle_point) {
+        float dist_sq = glm::dot(segment_point - triangle_point, segment_point - triangle_point);
+        if (dist_sq < best_dist_sq) {
+            best_dist_sq = dist_sq;
+            on_segment = segment_point;
+            on_triangle = triangle_point;
+        }
+    };
+
+    consider(seg_start, closest_point_on_triangle(seg_start, tri));
+    consider(seg_end, closest_point_on_triangle(seg_end, tri));
+
+    const glm::vec3 corners[3] = {tri.a, tri.b, tri.c};
+    for (int edge = 0; edge < 3; ++edge) {
+        glm::vec3 segment_point, edge_point;
+        closest_points_segments(seg_start, seg_end, corners[edge], corners[(edge + 1) % 3],
+                                segment_point, edge_point);
+        consider(segment_point, edge_point);
+    }
+}
+
 CollisionResult test_sphere_sphere(
     const SphereShape& a, glm::vec3 pos_a,
     const SphereShape& b, glm::vec3 pos_b)
@@ -147,7 +339,7 @@ CollisionResult test_sphere_aabb(
 
     float distance = std::sqrt(distance_sq);
     if (distance > 1e-6f) {
-        result.normal = delta / distance;
+        result.normal = -delta / distance;  // Normal points from sphere to AABB
         result.penetration = sphere.radius - distance;
     } else {
         // Sphere center is inside AABB, find minimum separation axis
@@ -157,15 +349,15 @@ CollisionResult test_sphere_aabb(
         overlap.y = aabb.half_extents.y - std::abs(to_center.y);
         overlap.z = aabb.half_extents.z - std::abs(to_center.z);
 
-        // Find axis with minimum penetration
+        // Find axis with minimum penetration (normal points into the AABB)
         if (overlap.x <= overlap.y && overlap.x <= overlap.z) {
-            result.normal = glm::vec3(to_center.x >= 0 ? 1.0f : -1.0f, 0.0f, 0.0f);
+            result.normal = glm::vec3(to_center.x >= 0 ? -1.0f : 1.0f, 0.0f, 0.0f);
             result.penetration = overlap.x + sphere.radius;
         } else if (overlap.y <= overlap.z) {
-            result.normal = glm::vec3(0.0f, to_center.y >= 0 ? 1.0f : -1.0f, 0.0f);
+            result.normal = glm::vec3(0.0f, to_center.y >= 0 ? -1.0f : 1.0f, 0.0f);
             result.penetration = overlap.y + sphere.radius;
         } else {
-            result.normal = glm::vec3(0.0f, 0.0f, to_center.z >= 0 ? 1.0f : -1.0f);
+            result.normal = glm::vec3(0.0f, 0.0f, to_center.z >= 0 ? -1.0f : 1.0f);
             result.penetration = overlap.z + sphere.radius;
         }
     }
@@ -315,10 +507,10 @@ CollisionResult test_capsule_aabb(
 
     float distance = std::sqrt(distance_sq);
     if (distance > 1e-6f) {
-        result.normal = -delta / distance;  // Normal points from AABB to capsule
+        result.normal = delta / distance;  // Normal points from capsule to AABB
         result.penetration = cap.radius - distance;
     } else {
-        // Capsule center is inside AABB
+        // Capsule center is inside AABB (normal points into the AABB)
         glm::vec3 to_center = best_cap_point - aabb_center;
         glm::vec3 overlap;
         overlap.x = aabb.half_extents.x - std::abs(to_center.x);
@@ -326,13 +518,13 @@ CollisionResult test_capsule_aabb(
         overlap.z = aabb.half_extents.z - std::abs(to_center.z);
 
         if (overlap.x <= overlap.y && overlap.x <= overlap.z) {
-            result.normal = glm::vec3(to_center.x >= 0 ? 1.0f : -1.0f, 0.0f, 0.0f);
+            result.normal = glm::vec3(to_center.x >= 0 ? -1.0f : 1.0f, 0.0f, 0.0f);
             result.penetration = overlap.x + cap.radius;
         } else if (overlap.y <= overlap.z) {
-            result.normal = glm::vec3(0.0f, to_center.y >= 0 ? 1.0f : -1.0f, 0.0f);
+            result.normal = glm::vec3(0.0f, to_center.y >= 0 ? -1.0f : 1.0f, 0.0f);
             result.penetration = overlap.y + cap.radius;
         } else {
-            result.normal = glm::vec3(0.0f, 0.0f, to_center.z >= 0 ? 1.0f : -1.0f);
+            result.normal = glm::vec3(0.0f, 0.0f, to_center.z >= 0 ? -1.0f : 1.0f);
             result.penetration = overlap.z + cap.radius;
         }
     }
@@ -382,63 +574,884 @@ CollisionResult test_capsule_sphere(
     return result;
 }
 
+// Triangle tests. Contacts push the convex shape out of the triangle's front
+// face: a shape more than its radius behind the plane doesn't touch, so
+// bodies can't be pulled through a thin surface from the back. The normal
+// points from the convex shape into the triangle.
+namespace {
+
+bool sphere_triangle_contact(glm::vec3 center, float radius, const Triangle& tri,
+                             CollisionResult& result) {
+    glm::vec3 normal = tri.normal();
+    if (normal == glm::vec3(0.0f)) return false;  // Degenerate
+
+    float distance_to_plane = glm::dot(center - tri.a, normal);
+    if (distance_to_plane <= -radius || distance_to_plane >= radius) return false;
+
+    glm::vec3 closest = closest_point_on_triangle(center, tri);
+    glm::vec3 delta = center - closest;
+    float distance_sq = glm::dot(delta, delta);
+    if (distance_sq >= radius * radius) return false;
+
+    float distance = std::sqrt(distance_sq);
+    result.collided = true;
+    result.contact_point = closest;
+
+    if (distance_to_plane > 0.0f && distance > 1e-6f) {
+        result.normal = -delta / distance;
+        result.penetration = radius - distance;
+    } else {
+        // Center on or behind the plane: push out through the front face
+        result.normal = -normal;
+        result.penetration = radius - distance_to_plane;
+    }
+    return true;
+}
+
+bool capsule_triangle_contact(glm::vec3 seg_start, glm::vec3 seg_end, float radius,
+                              const Triangle& tri, CollisionResult& result) {
+    glm::vec3 normal = tri.normal();
+    if (normal == glm::vec3(0.0f)) return false;  // Degenerate
+
+    float d0 = glm::dot(seg_start - tri.a, normal);
+    float d1 = glm::dot(seg_end - tri.a, normal);
+    if (std::min(d0, d1) >= radius || std::max(d0, d1) <= -radius) return false;
+
+    // Axis crossing the triangle: push the deeper end back out
+    if ((d0 < 0.0f) != (d1 < 0.0f)) {
+        glm::vec3 crossing = seg_start + (seg_end - seg_start) * (d0 / (d0 - d1));
+        if (point_in_triangle(crossing, tri, normal)) {
+            result.collided = true;
+            result.normal = -normal;
+            result.penetration = radius - std::min(d0, d1);
+            result.contact_point = crossing;
+            return true;
+        }
+    }
+
+    // Otherwise treat the point of the axis closest to the triangle as a sphere
+    glm::vec3 on_segment, on_triangle;
+    closest_points_segment_triangle(seg_start, seg_end, tri, on_segment, on_triangle);
+    return sphere_triangle_contact(on_segment, radius, tri, result);
+}
+
+// Separating axis test over the 3 box axes, the triangle normal and the 9
+// edge cross products; the axis of least overlap gives the contact normal
+bool aabb_triangle_contact(glm::vec3 center, glm::vec3 half_extents, const Triangle& tri,
+                           CollisionResult& result) {
+    glm::vec3 normal = tri.normal();
+    if (normal == glm::vec3(0.0f)) return false;  // Degenerate
+
+    const glm::vec3 v[3] = {tri.a - center, tri.b - center, tri.c - center};
+    const glm::vec3 edges[3] = {v[1] - v[0], v[2] - v[1], v[0] - v[2]};
+
+    float best_overlap = std::numeric_limits<float>::max();
+    glm::vec3 best_normal(0.0f);
+
+    // Returns false if the axis separates the shapes
+    auto test_axis = [&](glm::vec3 axis, bool front_only) {
+        float length_sq = glm::dot(axis, axis);
+        if (length_sq < 1e-10f) return true;  // Parallel edges, no axis
+        axis /= std::sqrt(length_sq);
+
+        float p0 = glm::dot(v[0], axis);
+        float p1 = glm::dot(v[1], axis);
+        float p2 = glm::dot(v[2], axis);
+        float tri_min = std::min({p0, p1, p2});
+        float tri_max = std::max({p0, p1, p2});
+        float box_radius = glm::dot(half_extents, glm::abs(axis));
+
+        if (tri_min >= box_radius || tri_max <= -box_radius) return false;
+
+        // Push the box towards -axis (normal +axis) or towards +axis (normal -axis)
+        float push_negative = box_radius - tri_min;
+        float push_positive = tri_max + box_radius;
+        if (!front_only && push_negative < push_positive) {
+            if (push_negative < best_overlap) {
+                best_overlap = push_negative;
+                best_normal = axis;
+            }
+        } else if (push_positive < best_overlap) {
+            best_overlap = push_positive;
+            best_normal = -axis;
+        }
+        return true;
+    };
+
+    // The face axis only pushes out of the front side
+    if (!test_axis(normal, true)) return false;
+
+    for (int axis = 0; axis < 3; ++axis) {
+        glm::vec3 box_axis(0.0f);
+        box_axis[axis] = 1.0f;
+        if (!test_axis(box_axis, false)) return false;
+        for (const glm::vec3& edge : edges) {
+            if (!test_axis(glm::cross(box_axis, edge), false)) return false;
+        }
+    }
+
+    result.collided = true;
+    result.normal = best_normal;
+    result.penetration = best_overlap;
+    result.contact_point = closest_point_on_triangle(center, tri);
+    return true;
+}
+
+// Deepest contact between a convex shape and the triangles of a mesh or
+// height field placed with its local origin at origin
+template <typename Geometry>
+CollisionResult test_shape_triangles(const CollisionShape& shape, glm::vec3 shape_pos,
+                                     const Geometry& geometry, glm::vec3 origin) {
+    CollisionResult deepest;
+
+    // Work in the geometry's local space
+    glm::vec3 local_pos = shape_pos - origin;
+    glm::vec3 center = local_pos + shape.offset();
+
+    glm::vec3 seg_start(0.0f), seg_end(0.0f);
+    if (shape.type == ShapeType::Capsule) {
+        float half_height = shape.capsule.half_cylinder_height();
+        seg_start = center + glm::vec3(0.0f, -half_height, 0.0f);
+        seg_end = center + glm::vec3(0.0f, half_height, 0.0f);
+    }
+
+    geometry.query(compute_aabb(shape, local_pos), [&](const Triangle& tri) {
+        CollisionResult contact;
+        bool touching = false;
+        switch (shape.type) {
+            case ShapeType::Sphere:
+                touching = sphere_triangle_contact(center, shape.sphere.radius, tri, contact);
+                break;
+            case ShapeType::AABB:
+                touching = aabb_triangle_contact(center, shape.aabb.half_extents, tri, contact);
+                break;
+            case ShapeType::Capsule:
+                touching = capsule_triangle_contact(seg_start, seg_end, shape.capsule.radius, tri, contact);
+                break;
+            default:
+                break;
+        }
+
+        if (touching && (!deepest.collided || contact.penetration > deepest.penetration)) {
+            deepest = contact;
+        }
+        return true;
+    });
+
+    if (deepest.collided) {
+        deepest.contact_point += origin;
+    }
+    return deepest;
+}
+
+}  // namespace
+
+CollisionResult test_shape_mesh(
+    const CollisionShape& shape, glm::vec3 shape_pos,
+    const MeshShape& mesh, glm::vec3 mesh_pos)
+{
+    if (!mesh.mesh) return CollisionResult{};
+    return test_shape_triangles(shape, shape_pos, *mesh.mesh, mesh_pos + mesh.offset);
+}
+
+CollisionResult test_shape_height_field(
+    const CollisionShape& shape, glm::vec3 shape_pos,
+    const HeightFieldShape& field, glm::vec3 field_pos)
+{
+    if (!field.field) return CollisionResult{};
+    return test_shape_triangles(shape, shape_pos, *field.field, field_pos + field.offset);
+}
+
+// Pair test dispatch table, indexed by [type of a][type of b]. Entries for
+// mirrored pairs run the test the other way round and flip the normal.
+namespace {
+
+using PairTestFn = CollisionResult (*)(const CollisionShape& a, glm::vec3 pos_a,
+                                       const CollisionShape& b, glm::vec3 pos_b);
+
+CollisionResult flipped(CollisionResult result) {
+    result.normal = -result.normal;
+    return result;
+}
+
+CollisionResult pair_none(const CollisionShape&, glm::vec3, const CollisionShape&, glm::vec3) {
+    return CollisionResult{};
+}
+
+CollisionResult pair_sphere_sphere(const CollisionShape& a, glm::vec3 pos_a,
+                                   const CollisionShape& b, glm::vec3 pos_b) {
+    return test_sphere_sphere(a.sphere, pos_a, b.sphere, pos_b);
+}
+
+CollisionResult pair_sphere_aabb(const CollisionShape& a, glm::vec3 pos_a,
+                                 const CollisionShape& b, glm::vec3 pos_b) {
+    return test_sphere_aabb(a.sphere, pos_a, b.aabb, pos_b);
+}
+
+CollisionResult pair_sphere_capsule(const CollisionShape& a, glm::vec3 pos_a,
+                                    const CollisionShape& b, glm::vec3 pos_b) {
+    return flipped(test_capsule_sphere(b.capsule, pos_b, a.sphere, pos_a));
+}
+
+CollisionResult pair_aabb_sphere(const CollisionShape& a, glm::vec3 pos_a,
+                                 const CollisionShape& b, glm::vec3 pos_b) {
+    return flipped(test_sphere_aabb(b.sphere, pos_b, a.aabb, pos_a));
+}
+
+CollisionResult pair_aabb_aabb(const CollisionShape& a, glm::vec3 pos_a,
+                               const CollisionShape& b, glm::vec3 pos_b) {
+    return test_aabb_aabb(a.aabb, pos_a, b.aabb, pos_b);
+}
+
+CollisionResult pair_aabb_capsule(const CollisionShape& a, glm::vec3 pos_a,
+                                  const CollisionShape& b, glm::vec3 pos_b) {
+    return flipped(test_capsule_aabb(b.capsule, pos_b, a.aabb, pos_a));
+}
+
+CollisionResult pair_capsule_sphere(const CollisionShape& a, glm::vec3 pos_a,
+                                    const CollisionShape& b, glm::vec3 pos_b) {
+    return test_capsule_sphere(a.capsule, pos_a, b.sphere, pos_b);
+}
+
+CollisionResult pair_capsule_aabb(const CollisionShape& a, glm::vec3 pos_a,
+                                  const CollisionShape& b, glm::vec3 pos_b) {
+    return test_capsule_aabb(a.capsule, pos_a, b.aabb, pos_b);
+}
+
+CollisionResult pair_capsule_capsule(const CollisionShape& a, glm::vec3 pos_a,
+                                     const CollisionShape& b, glm::vec3 pos_b) {
+    return test_capsule_capsule(a.capsule, pos_a, b.capsule, pos_b);
+}
+
+CollisionResult pair_shape_mesh(const CollisionShape& a, glm::vec3 pos_a,
+                                const CollisionShape& b, glm::vec3 pos_b) {
+    return test_shape_mesh(a, pos_a, b.mesh, pos_b);
+}
+
+CollisionResult pair_mesh_shape(const CollisionShape& a, glm::vec3 pos_a,
+                                const CollisionShape& b, glm::vec3 pos_b) {
+    return flipped(test_shape_mesh(b, pos_b, a.mesh, pos_a));
+}
+
+CollisionResult pair_shape_height_field(const CollisionShape& a, glm::vec3 pos_a,
+                                        const CollisionShape& b, glm::vec3 pos_b) {
+    return test_shape_height_field(a, pos_a, b.height_field, pos_b);
+}
+
+CollisionResult pair_height_field_shape(const CollisionShape& a, glm::vec3 pos_a,
+                                        const CollisionShape& b, glm::vec3 pos_b) {
+    return flipped(test_shape_height_field(b, pos_b, a.height_field, pos_a));
+}
+
+// Rows and columns follow ShapeType: None, Sphere, AABB, Capsule, Mesh,
+// HeightField. Static geometry never collides with static geometry.
+constexpr PairTestFn PAIR_TESTS[SHAPE_TYPE_COUNT][SHAPE_TYPE_COUNT] = {
+    {pair_none, pair_none,               pair_none,               pair_none,               pair_none,       pair_none},
+    {pair_none, pair_sphere_sphere,      pair_sphere_aabb,        pair_sphere_capsule,     pair_shape_mesh, pair_shape_height_field},
+    {pair_none, pair_aabb_sphere,        pair_aabb_aabb,          pair_aabb_capsule,       pair_shape_mesh, pair_shape_height_field},
+    {pair_none, pair_capsule_sphere,     pair_capsule_aabb,       pair_capsule_capsule,    pair_shape_mesh, pair_shape_height_field},
+    {pair_none, pair_mesh_shape,         pair_mesh_shape,         pair_mesh_shape,         pair_none,       pair_none},
+    {pair_none, pair_height_field_shape, pair_height_field_shape, pair_height_field_shape, pair_none,       pair_none},
+};
+
+}  // namespace
+
 CollisionResult test_collision(
     const CollisionShape& a, glm::vec3 pos_a,
     const CollisionShape& b, glm::vec3 pos_b)
 {
-    // Dispatch based on shape types
-    if (a.type == ShapeType::Sphere) {
-        const auto& sphere_a = static_cast<const SphereShape&>(a);
-        switch (b.type) {
-            case ShapeType::Sphere:
-                return test_sphere_sphere(sphere_a, pos_a,
-                    static_cast<const SphereShape&>(b), pos_b);
-            case ShapeType::AABB:
-                return test_sphere_aabb(sphere_a, pos_a,
-                    static_cast<const AABBShape&>(b), pos_b);
-            case ShapeType::Capsule: {
-                // Reverse the test and flip the normal
-                auto result = test_capsule_sphere(
-                    static_cast<const CapsuleShape&>(b), pos_b, sphere_a, pos_a);
-                result.normal = -result.normal;
-                return result;
+    return PAIR_TESTS[static_cast<int>(a.type)][static_cast<int>(b.type)](a, pos_a, b, pos_b);
+}
+
+SweepResult sweep_sphere_sphere(
+    float radius, glm::vec3 start, glm::vec3 motion,
+    const SphereShape& sphere, glm::vec3 sphere_pos)
+{
+    SweepResult result;
+
+    glm::vec3 center = sphere_pos + sphere.offset;
+
+    float t;
+    if (!intersect_ray_sphere(start, motion, 1.0f, center, sphere.radius + radius, t)) {
+        return result;
+    }
+
+    glm::vec3 swept_center = start + motion * t;
+    result.hit = true;
+    result.time = t;
+    result.normal = sweep_normal(swept_center, center, motion);
+    result.contact_point = center + result.normal * sphere.radius;
+    return result;
+}
+
+SweepResult sweep_sphere_aabb(
+    float radius, glm::vec3 start, glm::vec3 motion,
+    const AABBShape& aabb, glm::vec3 aabb_pos)
+{
+    SweepResult result;
+
+    glm::vec3 aabb_center = aabb_pos + aabb.offset;
+    glm::vec3 box_min = aabb_center - aabb.half_extents;
+    glm::vec3 box_max = aabb_center + aabb.half_extents;
+
+    // Box grown by the radius on every axis bounds the rounded box
+    float t;
+    if (!intersect_ray_box(start, motion, 1.0f, box_min - glm::vec3(radius), box_max + glm::vec3(radius), t)) {
+        return result;
+    }
+
+    // Entry point outside the original box on two or three axes lies in an
+    // edge or corner region, where the rounded box is a capsule around the edge
+    glm::vec3 entry = start + motion * t;
+    int below = 0;
+    int above = 0;
+    for (int axis = 0; axis < 3; ++axis) {
+        if (entry[axis] < box_min[axis]) below |= 1 << axis;
+        if (entry[axis] > box_max[axis]) above |= 1 << axis;
+    }
+    int outside = below | above;
+    int outside_count = ((outside >> 0) & 1) + ((outside >> 1) & 1) + ((outside >> 2) & 1);
+
+    if (outside_count >= 2) {
+        // Corner picks max on the axes set in the mask, min on the others
+        auto corner = [&](int mask) {
+            return glm::vec3((mask & 1) ? box_max.x : box_min.x,
+                             (mask & 2) ? box_max.y : box_min.y,
+                             (mask & 4) ? box_max.z : box_min.z);
+        };
+
+        float te;
+        float best = std::numeric_limits<float>::infinity();
+        if (outside_count == 3) {
+            // Corner region: any of the three edges meeting at the corner
+            for (int axis = 0; axis < 3; ++axis) {
+                if (intersect_ray_capsule(start, motion, 1.0f, corner(above),
+                                          corner(above ^ (1 << axis)), radius, te)) {
+                    best = std::min(best, te);
+                }
             }
+        } else if (intersect_ray_capsule(start, motion, 1.0f, corner(below ^ 7), corner(above), radius, te)) {
+            // Edge region: the edge along the one axis the entry point is inside on
+            best = te;
+        }
+
+        if (best > 1.0f) return result;
+        t = best;
+    }
+
+    glm::vec3 swept_center = start + motion * t;
+    glm::vec3 closest = glm::clamp(swept_center, box_min, box_max);
+
+    result.hit = true;
+    result.time = t;
+    result.contact_point = closest;
+    if (glm::dot(swept_center - closest, swept_center - closest) > 1e-12f) {
+        result.normal = glm::normalize(swept_center - closest);
+    } else {
+        result.normal = aabb_face_normal(swept_center, aabb_center, aabb.half_extents);
+    }
+    return result;
+}
+
+SweepResult sweep_sphere_capsule(
+    float radius, glm::vec3 start, glm::vec3 motion,
+    const CapsuleShape& cap, glm::vec3 cap_pos)
+{
+    SweepResult result;
+
+    glm::vec3 cap_center = cap_pos + cap.offset;
+    float half_height = std::max(cap.half_cylinder_height(), 0.0f);
+    glm::vec3 cap_bottom = cap_center + glm::vec3(0.0f, -half_height, 0.0f);
+    glm::vec3 cap_top = cap_center + glm::vec3(0.0f, half_height, 0.0f);
+
+    float t;
+    if (!intersect_ray_capsule(start, motion, 1.0f, cap_bottom, cap_top, cap.radius + radius, t)) {
+        return result;
+    }
+
+    glm::vec3 swept_center = start + motion * t;
+    glm::vec3 axis_point = closest_point_on_segment(swept_center, cap_bottom, cap_top);
+
+    result.hit = true;
+    result.time = t;
+    result.normal = sweep_normal(swept_center, axis_point, motion);
+    result.contact_point = axis_point + result.normal * cap.radius;
+    return result;
+}
+
+namespace {
+
+// Helper: Entry time of a sphere moving along motion into a triangle (face
+// from either side, then the edges as capsules, which also cover the corners)
+bool sweep_sphere_triangle(float radius, glm::vec3 start, glm::vec3 motion, float t_max,
+                           const Triangle& tri, float& t) {
+    glm::vec3 normal = tri.normal();
+    if (normal == glm::vec3(0.0f)) return false;  // Degenerate
+
+    glm::vec3 closest = closest_point_on_triangle(start, tri);
+    if (glm::dot(start - closest, start - closest) <= radius * radius) {
+        t = 0.0f;  // Already touching
+        return true;
+    }
+
+    float best = std::numeric_limits<float>::infinity();
+
+    float distance_to_plane = glm::dot(start - tri.a, normal);
+    float approach = glm::dot(motion, normal);
+    float side = distance_to_plane >= 0.0f ? 1.0f : -1.0f;
+    if (approach * side < 0.0f) {
+        float tf = (distance_to_plane - side * radius) / -approach;
+        if (tf >= 0.0f && tf <= t_max &&
+            point_in_triangle(start + motion * tf - side * radius * normal, tri, normal)) {
+            best = tf;
+        }
+    }
+
+    const glm::vec3 corners[3] = {tri.a, tri.b, tri.c};
+    for (int edge = 0; edge < 3; ++edge) {
+        float te;
+        if (intersect_ray_capsule(start, motion, std::min(best, t_max), corners[edge],
+                                  corners[(edge + 1) % 3], radius, te)) {
+            best = std::min(best, te);
+        }
+    }
+
+    if (best > t_max) return false;
+    t = best;
+    return true;
+}
+
+template <typename Geometry>
+SweepResult sweep_sphere_triangles(float radius, glm::vec3 start, glm::vec3 motion,
+                                   const Geometry& geometry, glm::vec3 origin) {
+    SweepResult result;
+
+    glm::vec3 local_start = start - origin;
+    glm::vec3 local_end = local_start + motion;
+    AABB swept(glm::min(local_start, local_end) - glm::vec3(radius),
+               glm::max(local_start, local_end) + glm::vec3(radius));
+
+    float best = std::numeric_limits<float>::infinity();
+    Triangle best_triangle;
+    geometry.query(swept, [&](const Triangle& tri) {
+        float t;
+        if (sweep_sphere_triangle(radius, local_start, motion, std::min(best, 1.0f), tri, t) && t < best) {
+            best = t;
+            best_triangle = tri;
+        }
+        return true;
+    });
+
+    if (best > 1.0f) return result;
+
+    glm::vec3 swept_center = local_start + motion * best;
+    glm::vec3 closest = closest_point_on_triangle(swept_center, best_triangle);
+
+    result.hit = true;
+    result.time = best;
+    result.normal = sweep_normal(swept_center, closest, motion);
+    result.contact_point = closest + origin;
+    return result;
+}
+
+}  // namespace
+
+SweepResult sweep_sphere_mesh(
+    float radius, glm::vec3 start, glm::vec3 motion,
+    const MeshShape& mesh, glm::vec3 mesh_pos)
+{
+    if (!mesh.mesh) return SweepResult{};
+    return sweep_sphere_triangles(radius, start, motion, *mesh.mesh, mesh_pos + mesh.offset);
+}
+
+SweepResult sweep_sphere_height_field(
+    float radius, glm::vec3 start, glm::vec3 motion,
+    const HeightFieldShape& field, glm::vec3 field_pos)
+{
+    if (!field.field) return SweepResult{};
+    return sweep_sphere_triangles(radius, start, motion, *field.field, field_pos + field.offset);
+}
+
+SweepResult sweep_sphere(
+    float radius, glm::vec3 start, glm::vec3 motion,
+    const CollisionShape& shape, glm::vec3 shape_pos)
+{
+    switch (shape.type) {
+        case ShapeType::None:
+            break;
+        case ShapeType::Sphere:
+            return sweep_sphere_sphere(radius, start, motion, shape.sphere, shape_pos);
+        case ShapeType::AABB:
+            return sweep_sphere_aabb(radius, start, motion, shape.aabb, shape_pos);
+        case ShapeType::Capsule:
+            return sweep_sphere_capsule(radius, start, motion, shape.capsule, shape_pos);
+        case ShapeType::Mesh:
+            return sweep_sphere_mesh(radius, start, motion, shape.mesh, shape_pos);
+        case ShapeType::HeightField:
+            return sweep_sphere_height_field(radius, start, motion, shape.height_field, shape_pos);
+    }
+
+    return SweepResult{};
+}
+
+namespace {
+
+// Helper: Entry time of a sphere moving along motion into the prism a
+// triangle sweeps when moved half_height up and down (the triangle grown by a
+// vertical segment). The prism is convex, so the sphere first touches one of
+// its faces (the two caps and up to three side walls) or one of its nine
+// edges (capsules, which also cover the corners).
+bool sweep_sphere_prism(float radius, glm::vec3 start, glm::vec3 motion, float t_max,
+                        const Triangle& tri, float half_height, float& t) {
+    if (half_height < 1e-6f) return sweep_sphere_triangle(radius, start, motion, t_max, tri, t);
+
+    glm::vec3 normal = tri.normal();
+    if (normal == glm::vec3(0.0f)) return false;  // Degenerate
+
+    // Already touching: the vertical segment through start crosses the
+    // triangle or comes within the radius of it
+    glm::vec3 up(0.0f, half_height, 0.0f);
+    float d0 = glm::dot(start - up - tri.a, normal);
+    float d1 = glm::dot(start + up - tri.a, normal);
+    if ((d0 < 0.0f) != (d1 < 0.0f) &&
+        point_in_triangle(start - up + 2.0f * up * (d0 / (d0 - d1)), tri, normal)) {
+        t = 0.0f;
+        return true;
+    }
+    glm::vec3 on_segment, on_triangle;
+    closest_points_segment_triangle(start - up, start + up, tri, on_segment, on_triangle);
+    if (glm::dot(on_segment - on_triangle, on_segment - on_triangle) <= radius * radius) {
+        t = 0.0f;
+        return true;
+    }
+
+    float best = std::numeric_limits<float>::infinity();
+
+    // Face hit: the sphere reaches the face's plane (from either side) at a
+    // point inside the face
+    auto face = [&](glm::vec3 point_on_plane, glm::vec3 face_normal, auto&& inside) {
+        float distance = glm::dot(start - point_on_plane, face_normal);
+        float approach = glm::dot(motion, face_normal);
+        float side = distance >= 0.0f ? 1.0f : -1.0f;
+        if (approach * side >= 0.0f) return;
+
+        float tf = (distance - side * radius) / -approach;
+        if (tf < 0.0f || tf > std::min(best, t_max)) return;
+        if (inside(start + motion * tf - side * radius * face_normal)) best = tf;
+    };
+
+    for (float sign : {1.0f, -1.0f}) {
+        Triangle cap{tri.a + sign * up, tri.b + sign * up, tri.c + sign * up};
+        face(cap.a, normal, [&](glm::vec3 p) { return point_in_triangle(p, cap, normal); });
+    }
+
+    const glm::vec3 corners[3] = {tri.a, tri.b, tri.c};
+    for (int edge = 0; edge < 3; ++edge) {
+        glm::vec3 p = corners[edge];
+        glm::vec3 e = corners[(edge + 1) % 3] - p;
+        float horizontal_sq = e.x * e.x + e.z * e.z;
+        if (horizontal_sq < 1e-12f) continue;  // Vertical edge: no wall
+
+        // Wall p + s * e + v * Y for s in [0, 1], |v| <= half_height
+        glm::vec3 wall_normal = glm::normalize(glm::vec3(e.z, 0.0f, -e.x));
+        face(p, wall_normal, [&](glm::vec3 x) {
+            float s = ((x.x - p.x) * e.x + (x.z - p.z) * e.z) / horizontal_sq;
+            float v = x.y - p.y - s * e.y;
+            return s >= 0.0f && s <= 1.0f && std::abs(v) <= half_height;
+        });
+    }
+
+    for (int edge = 0; edge < 3; ++edge) {
+        glm::vec3 p = corners[edge];
+        glm::vec3 q = corners[(edge + 1) % 3];
+        float te;
+        if (intersect_ray_capsule(start, motion, std::min(best, t_max), p + up, q + up, radius, te)) best = std::min(best, te);
+        if (intersect_ray_capsule(start, motion, std::min(best, t_max), p - up, q - up, radius, te)) best = std::min(best, te);
+        if (intersect_ray_capsule(start, motion, std::min(best, t_max), p - up, p + up, radius, te)) best = std::min(best, te);
+    }
+
+    if (best > t_max) return false;
+    t = best;
+    return true;
+}
+
+template <typename Geometry>
+SweepResult sweep_capsule_triangles(float radius, float half_height, glm::vec3 start, glm::vec3 motion,
+                                    const Geometry& geometry, glm::vec3 origin) {
+    SweepResult result;
+
+    glm::vec3 local_start = start - origin;
+    glm::vec3 local_end = local_start + motion;
+    glm::vec3 extent(radius, radius + half_height, radius);
+    AABB swept(glm::min(local_start, local_end) - extent, glm::max(local_start, local_end) + extent);
+
+    float best = std::numeric_limits<float>::infinity();
+    Triangle best_triangle;
+    geometry.query(swept, [&](const Triangle& tri) {
+        float t;
+        if (sweep_sphere_prism(radius, local_start, motion, std::min(best, 1.0f), tri, half_height, t) &&
+            t < best) {
+            best = t;
+            best_triangle = tri;
+        }
+        return true;
+    });
+
+    if (best > 1.0f) return result;
+
+    glm::vec3 swept_center = local_start + motion * best;
+    glm::vec3 up(0.0f, half_height, 0.0f);
+    glm::vec3 on_segment, on_triangle;
+    closest_points_segment_triangle(swept_center - up, swept_center + up, best_triangle,
+                                    on_segment, on_triangle);
+
+    result.hit = true;
+    result.time = best;
+    result.normal = sweep_normal(on_segment, on_triangle, motion);
+    result.contact_point = on_triangle + origin;
+    return result;
+}
+
+}  // namespace
+
+SweepResult sweep_capsule(
+    const CapsuleShape& capsule, glm::vec3 start, glm::vec3 motion,
+    const CollisionShape& shape, glm::vec3 shape_pos)
+{
+    // Sweep the capsule's center against the shape grown by its axis
+    glm::vec3 center = start + capsule.offset;
+    float half_height = std::max(capsule.half_cylinder_height(), 0.0f);
+
+    SweepResult result;
+    switch (shape.type) {
+        case ShapeType::None:
+            break;
+        case ShapeType::Sphere: {
+            const SphereShape& sphere = shape.sphere;
+            CapsuleShape grown(sphere.radius, 2.0f * (half_height + sphere.radius), sphere.offset);
+            result = sweep_sphere_capsule(capsule.radius, center, motion, grown, shape_pos);
+            result.contact_point = shape_pos + sphere.offset + result.normal * sphere.radius;
+            break;
+        }
+        case ShapeType::AABB: {
+            const AABBShape& aabb = shape.aabb;
+            AABBShape grown(aabb.half_extents + glm::vec3(0.0f, half_height, 0.0f), aabb.offset);
+            result = sweep_sphere_aabb(capsule.radius, center, motion, grown, shape_pos);
+            result.contact_point = clamp_to_aabb(result.contact_point, shape_pos + aabb.offset, aabb.half_extents);
+            break;
+        }
+        case ShapeType::Capsule: {
+            const CapsuleShape& other = shape.capsule;
+            float other_half_height = std::max(other.half_cylinder_height(), 0.0f);
+            CapsuleShape grown(other.radius, 2.0f * (half_height + other_half_height + other.radius), other.offset);
+            result = sweep_sphere_capsule(capsule.radius, center, motion, grown, shape_pos);
+
+            glm::vec3 other_center = shape_pos + other.offset;
+            glm::vec3 other_up(0.0f, other_half_height, 0.0f);
+            glm::vec3 axis_point = closest_point_on_segment(result.contact_point, other_center - other_up,
+                                                            other_center + other_up);
+            result.contact_point = axis_point + result.normal * other.radius;
+            break;
         }
-    } else if (a.type == ShapeType::AABB) {
-        const auto& aabb_a = static_cast<const AABBShape&>(a);
-        switch (b.type) {
-            case ShapeType::Sphere: {
-                auto result = test_sphere_aabb(
-                    static_cast<const SphereShape&>(b), pos_b, aabb_a, pos_a);
-                result.normal = -result.normal;
-                return result;
+        case ShapeType::Mesh:
+            if (shape.mesh.mesh) {
+                result = sweep_capsule_triangles(capsule.radius, half_height, center, motion,
+                                                 *shape.mesh.mesh, shape_pos + shape.mesh.offset);
             }
-            case ShapeType::AABB:
-                return test_aabb_aabb(aabb_a, pos_a,
-                    static_cast<const AABBShape&>(b), pos_b);
-            case ShapeType::Capsule: {
-                auto result = test_capsule_aabb(
-                    static_cast<const CapsuleShape&>(b), pos_b, aabb_a, pos_a);
-                result.normal = -result.normal;
-                return result;
+            break;
+        case ShapeType::HeightField:
+            if (shape.height_field.field) {
+                result = sweep_capsule_triangles(capsule.radius, half_height, center, motion,
+                                                 *shape.height_field.field, shape_pos + shape.height_field.offset);
             }
+            break;
+    }
+
+    return result;
+}
+
+SweepResult test_segment(
+    glm::vec3 start, glm::vec3 end,
+    const CollisionShape& shape, glm::vec3 shape_pos)
+{
+    return sweep_sphere(0.0f, start, end - start, shape, shape_pos);
+}
+
+RayResult raycast_sphere(
+    glm::vec3 origin, glm::vec3 direction, float max_dist,
+    const SphereShape& sphere, glm::vec3 sphere_pos)
+{
+    RayResult result;
+
+    glm::vec3 center = sphere_pos + sphere.offset;
+
+    float t;
+    if (!intersect_ray_sphere(origin, direction, max_dist, center, sphere.radius, t) || t <= 0.0f) {
+        return result;
+    }
+
+    result.hit = true;
+    result.distance = t;
+    result.normal = sweep_normal(origin + direction * t, center, direction);
+    return result;
+}
+
+RayResult raycast_aabb(
+    glm::vec3 origin, glm::vec3 direction, float max_dist,
+    const AABBShape& aabb, glm::vec3 aabb_pos)
+{
+    RayResult result;
+
+    glm::vec3 aabb_center = aabb_pos + aabb.offset;
+
+    float t;
+    if (!intersect_ray_box(origin, direction, max_dist, aabb_center - aabb.half_extents,
+                           aabb_center + aabb.half_extents, t) || t <= 0.0f) {
+        return result;
+    }
+
+    result.hit = true;
+    result.distance = t;
+    result.normal = aabb_face_normal(origin + direction * t, aabb_center, aabb.half_extents);
+    return result;
+}
+
+RayResult raycast_capsule(
+    glm::vec3 origin, glm::vec3 direction, float max_dist,
+    const CapsuleShape& cap, glm::vec3 cap_pos)
+{
+    RayResult result;
+
+    glm::vec3 cap_center = cap_pos + cap.offset;
+    float half_height = std::max(cap.half_cylinder_height(), 0.0f);
+    glm::vec3 cap_bottom = cap_center + glm::vec3(0.0f, -half_height, 0.0f);
+    glm::vec3 cap_top = cap_center + glm::vec3(0.0f, half_height, 0.0f);
+
+    float t;
+    if (!intersect_ray_capsule(origin, direction, max_dist, cap_bottom, cap_top, cap.radius, t) || t <= 0.0f) {
+        return result;
+    }
+
+    glm::vec3 point = origin + direction * t;
+    result.hit = true;
+    result.distance = t;
+    result.normal = sweep_normal(point, closest_point_on_segment(point, cap_bottom, cap_top), direction);
+    return result;
+}
+
+namespace {
+
+// Helper: Ray vs triangle from either side (Moller-Trumbore)
+bool intersect_ray_triangle(glm::vec3 origin, glm::vec3 direction, float max_dist,
+                            const Triangle& tri, float& t) {
+    glm::vec3 ab = tri.b - tri.a;
+    glm::vec3 ac = tri.c - tri.a;
+    glm::vec3 p = glm::cross(direction, ac);
+    float det = glm::dot(ab, p);
+    if (std::abs(det) < 1e-12f) return false;  // Parallel or degenerate
+
+    float inv_det = 1.0f / det;
+    glm::vec3 s = origin - tri.a;
+    float u = glm::dot(s, p) * inv_det;
+    if (u < 0.0f || u > 1.0f) return false;
+
+    glm::vec3 q = glm::cross(s, ab);
+    float v = glm::dot(direction, q) * inv_det;
+    if (v < 0.0f || u + v > 1.0f) return false;
+
+    t = glm::dot(ac, q) * inv_det;
+    return t > 0.0f && t <= max_dist;
+}
+
+template <typename Geometry>
+RayResult raycast_triangles(glm::vec3 origin, glm::vec3 direction, float max_dist,
+                            const Geometry& geometry, glm::vec3 geometry_origin) {
+    RayResult result;
+
+    geometry.raycast(origin - geometry_origin, direction, max_dist, [&](const Triangle& tri, float closest) {
+        float t;
+        if (!intersect_ray_triangle(origin - geometry_origin, direction, closest, tri, t)) return closest;
+
+        glm::vec3 normal = tri.normal();
+        result.hit = true;
+        result.distance = t;
+        result.normal = glm::dot(normal, direction) > 0.0f ? -normal : normal;  // Facing the ray
+        return t;
+    });
+
+    return result;
+}
+
+}  // namespace
+
+RayResult raycast_mesh(
+    glm::vec3 origin, glm::vec3 direction, float max_dist,
+    const MeshShape& mesh, glm::vec3 mesh_pos)
+{
+    if (!mesh.mesh) return RayResult{};
+    return raycast_triangles(origin, direction, max_dist, *mesh.mesh, mesh_pos + mesh.offset);
+}
+
+RayResult raycast_height_field(
+    glm::vec3 origin, glm::vec3 direction, float max_dist,
+    const HeightFieldShape& field, glm::vec3 field_pos)
+{
+    if (!field.field) return RayResult{};
+    return raycast_triangles(origin, direction, max_dist, *field.field, field_pos + field.offset);
+}
+
+RayResult raycast_shape(
+    glm::vec3 origin, glm::vec3 direction, float max_dist,
+    const CollisionShape& shape, glm::vec3 shape_pos)
+{
+    switch (shape.type) {
+        case ShapeType::None:
+            break;
+        case ShapeType::Sphere:
+            return raycast_sphere(origin, direction, max_dist, shape.sphere, shape_pos);
+        case ShapeType::AABB:
+            return raycast_aabb(origin, direction, max_dist, shape.aabb, shape_pos);
+        case ShapeType::Capsule:
+            return raycast_capsule(origin, direction, max_dist, shape.capsule, shape_pos);
+        case ShapeType::Mesh:
+            return raycast_mesh(origin, direction, max_dist, shape.mesh, shape_pos);
+        case ShapeType::HeightField:
+            return raycast_height_field(origin, direction, max_dist, shape.height_field, shape_pos);
+    }
+
+    return RayResult{};
+}
+
+AABB compute_aabb(const CollisionShape& shape, glm::vec3 position) {
+    glm::vec3 center = position + shape.offset();
+    glm::vec3 half_extents(0.0f);
+
+    switch (shape.type) {
+        case ShapeType::None:
+            break;
+        case ShapeType::Sphere:
+            half_extents = glm::vec3(shape.sphere.radius);
+            break;
+        case ShapeType::AABB:
+            half_extents = shape.aabb.half_extents;
+            break;
+        case ShapeType::Capsule: {
+            const CapsuleShape& capsule = shape.capsule;
+            // Vertical capsule: radius on XZ, half total height on Y
+            half_extents = glm::vec3(capsule.radius,
+                std::max(capsule.height * 0.5f, capsule.radius), capsule.radius);
+            break;
         }
-    } else if (a.type == ShapeType::Capsule) {
-        const auto& capsule_a = static_cast<const CapsuleShape&>(a);
-        switch (b.type) {
-            case ShapeType::Sphere:
-                return test_capsule_sphere(capsule_a, pos_a,
-                    static_cast<const SphereShape&>(b), pos_b);
-            case ShapeType::AABB:
-                return test_capsule_aabb(capsule_a, pos_a,
-                    static_cast<const AABBShape&>(b), pos_b);
-            case ShapeType::Capsule:
-                return test_capsule_capsule(capsule_a, pos_a,
-                    static_cast<const CapsuleShape&>(b), pos_b);
-        }
+        case ShapeType::Mesh:
+            if (!shape.mesh.mesh) break;
+            return AABB(center + shape.mesh.mesh->bounds().min, center + shape.mesh.mesh->bounds().max);
+        case ShapeType::HeightField:
+            if (!shape.height_field.field) break;
+            return AABB(center + shape.height_field.field->bounds().min,
+                        center + shape.height_field.field->bounds().max);
     }
 
-    return CollisionResult{};  // Unknown shape types
+    return AABB(center - half_extents, center + half_extents);
 }
 
 }  // namespace engine::physics
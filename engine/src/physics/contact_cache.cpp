@@ -0,0 +1,34 @@
+#include <engine/physics/contact_cache.hpp>
+
+#include <algorithm>
+
+namespace engine::physics {
+
+const CachedContact* ContactCache::find(uint64_t key) const {
+    auto it = std::lower_bound(_previous.begin(), _previous.end(), key,
+        [](const CachedContact& contact, uint64_t k) { return contact.key < k; });
+    if (it == _previous.end() || it->key != key) return nullptr;
+    return &*it;
+}
+
+void ContactCache::end_step() {
+    std::sort(_current.begin(), _current.end(),
+        [](const CachedContact& a, const CachedContact& b) { return a.key < b.key; });
+    _previous.swap(_current);
+    _current.clear();
+}
+
+void ContactCache::remove_slot(uint32_t slot) {
+    auto involves_slot = [slot](const CachedContact& contact) {
+        return static_cast<uint32_t>(contact.key >> 32) == slot ||
+               static_cast<uint32_t>(contact.key) == slot;
+    };
+    _previous.erase(std::remove_if(_previous.begin(), _previous.end(), involves_slot), _previous.end());
+}
+
+void ContactCache::clear() {
+    _previous.clear();
+    _current.clear();
+}
+
+}  // namespace engine::physics
@@ -0,0 +1,306 @@
+#include <engine/physics/dynamic_aabb_tree.hpp>
+
+#include <algorithm>
+#include <cassert>
+
+namespace engine::physics {
+
+int DynamicAABBTree::allocate_node() {
+    if (_free_list == NULL_NODE) {
+        _nodes.emplace_back();
+        _free_list = static_cast<int>(_nodes.size()) - 1;
+        _nodes[_free_list].parent = NULL_NODE;
+    }
+
+    int id = _free_list;
+    _free_list = _nodes[id].parent;
+
+    Node& node = _nodes[id];
+    node.parent = NULL_NODE;
+    node.child1 = NULL_NODE;
+    node.child2 = NULL_NODE;
+    node.height = 0;
+    node.user_id = 0;
+    return id;
+}
+
+void DynamicAABBTree::free_node(int node) {
+    _nodes[node].parent = _free_list;
+    _nodes[node].height = -1;
+    _free_list = node;
+}
+
+int DynamicAABBTree::create_proxy(const AABB& aabb, uint32_t user_id) {
+    int id = allocate_node();
+    _nodes[id].aabb = aabb.expanded(AABB_MARGIN);
+    _nodes[id].user_id = user_id;
+    insert_leaf(id);
+    ++_proxy_count;
+    return id;
+}
+
+void DynamicAABBTree::destroy_proxy(int proxy_id) {
+    assert(_nodes[proxy_id].is_leaf());
+    remove_leaf(proxy_id);
+    free_node(proxy_id);
+    --_proxy_count;
+}
+
+bool DynamicAABBTree::move_proxy(int proxy_id, const AABB& aabb, glm::vec3 displacement) {
+    // Extend the fat box in the direction of motion so it survives several steps
+    AABB fat = aabb.expanded(AABB_MARGIN);
+    glm::vec3 d = displacement * DISPLACEMENT_MULTIPLIER;
+    for (int axis = 0; axis < 3; ++axis) {
+        if (d[axis] < 0.0f) {
+            fat.min[axis] += d[axis];
+        } else {
+            fat.max[axis] += d[axis];
+        }
+    }
+
+    const AABB& tree_aabb = _nodes[proxy_id].aabb;
+    if (tree_aabb.contains(aabb)) {
+        // Still inside; only re-insert if the fat box has become far too loose
+        AABB huge = fat.expanded(4.0f * AABB_MARGIN);
+        if (huge.contains(tree_aabb)) {
+            return false;
+        }
+    }
+
+    remove_leaf(proxy_id);
+    _nodes[proxy_id].aabb = fat;
+    insert_leaf(proxy_id);
+    return true;
+}
+
+void DynamicAABBTree::clear() {
+    _nodes.clear();
+    _root = NULL_NODE;
+    _free_list = NULL_NODE;
+    _proxy_count = 0;
+}
+
+void DynamicAABBTree::insert_leaf(int leaf) {
+    if (_root == NULL_NODE) {
+        _root = leaf;
+        _nodes[_root].parent = NULL_NODE;
+        return;
+    }
+
+    // Step 1: Find the best sibling using the surface area heuristic
+    AABB leaf_aabb = _nodes[leaf].aabb;
+    int index = _root;
+    while (!_nodes[index].is_leaf()) {
+        const Node& node = _nodes[index];
+        int child1 = node.child1;
+        int child2 = node.child2;
+
+        float area = node.aabb.surface_area();
+        float combined_area = node.aabb.merged(leaf_aabb).surface_area();
+
+        // Cost of creating a new parent for this node and the new leaf
+        float cost = 2.0f * combined_area;
+
+        // Minimum cost of pushing the leaf further down the tree
+        float inheritance_cost = 2.0f * (combined_area - area);
+
+        auto descend_cost = [&](int child) {
+            const Node& c = _nodes[child];
+            float merged_area = c.aabb.merged(leaf_aabb).surface_area();
+            if (c.is_leaf()) {
+                return merged_area + inheritance_cost;
+            }
+            return merged_area - c.aabb.surface_area() + inheritance_cost;
+        };
+
+        float cost1 = descend_cost(child1);
+        float cost2 = descend_cost(child2);
+
+        if (cost < cost1 && cost < cost2) break;
+
+        index = cost1 < cost2 ? child1 : child2;
+    }
+
+    int sibling = index;
+
+    // Step 2: Create a new parent for the sibling and the leaf
+    int old_parent = _nodes[sibling].parent;
+    int new_parent = allocate_node();
+    _nodes[new_parent].parent = old_parent;
+    _nodes[new_parent].aabb = leaf_aabb.merged(_nodes[sibling].aabb);
+    _nodes[new_parent].height = _nodes[sibling].height + 1;
+    _nodes[new_parent].child1 = sibling;
+    _nodes[new_parent].child2 = leaf;
+    _nodes[sibling].parent = new_parent;
+    _nodes[leaf].parent = new_parent;
+
+    if (old_parent != NULL_NODE) {
+        if (_nodes[old_parent].child1 == sibling) {
+            _nodes[old_parent].child1 = new_parent;
+        } else {
+            _nodes[old_parent].child2 = new_parent;
+        }
+    } else {
+        _root = new_parent;
+    }
+
+    // Step 3: Walk back up, refitting and rebalancing ancestors
+    index = _nodes[leaf].parent;
+    while (index != NULL_NODE) {
+        index = balance(index);
+
+        Node& node = _nodes[index];
+        node.height = 1 + std::max(_nodes[node.child1].height, _nodes[node.child2].height);
+        node.aabb = _nodes[node.child1].aabb.merged(_nodes[node.child2].aabb);
+
+        index = node.parent;
+    }
+}
+
+void DynamicAABBTree::remove_leaf(int leaf) {
+    if (leaf == _root) {
+        _root = NULL_NODE;
+        return;
+    }
+
+    int parent = _nodes[leaf].parent;
+    int grand_parent = _nodes[parent].parent;
+    int sibling = _nodes[parent].child1 == leaf ? _nodes[parent].child2 : _nodes[parent].child1;
+
+    if (grand_parent == NULL_NODE) {
+        _root = sibling;
+        _nodes[sibling].parent = NULL_NODE;
+        free_node(parent);
+        return;
+    }
+
+    // Replace the parent with the sibling and refit ancestors
+    if (_nodes[grand_parent].child1 == parent) {
+        _nodes[grand_parent].child1 = sibling;
+    } else {
+        _nodes[grand_parent].child2 = sibling;
+    }
+    _nodes[sibling].parent = grand_parent;
+    free_node(parent);
+
+    int index = grand_parent;
+    while (index != NULL_NODE) {
+        index = balance(index);
+
+        Node& node = _nodes[index];
+        node.aabb = _nodes[node.child1].aabb.merged(_nodes[node.child2].aabb);
+        node.height = 1 + std::max(_nodes[node.child1].height, _nodes[node.child2].height);
+
+        index = node.parent;
+    }
+}
+
+// Rotate node A up if one of its children is unbalanced by more than one
+// level. Returns the index of the node now at A's position.
+int DynamicAABBTree::balance(int i_a) {
+    Node& a = _nodes[i_a];
+    if (a.is_leaf() || a.height < 2) {
+        return i_a;
+    }
+
+    int i_b = a.child1;
+    int i_c = a.child2;
+    Node& b = _nodes[i_b];
+    Node& c = _nodes[i_c];
+
+    int balance_factor = c.height - b.height;
+
+    // Rotate C up
+    if (balance_factor > 1) {
+        int i_f = c.child1;
+        int i_g = c.child2;
+        Node& f = _nodes[i_f];
+        Node& g = _nodes[i_g];
+
+        // Swap A and C
+        c.child1 = i_a;
+        c.parent = a.parent;
+        a.parent = i_c;
+
+        // A's old parent should point to C
+        if (c.parent != NULL_NODE) {
+            if (_nodes[c.parent].child1 == i_a) {
+                _nodes[c.parent].child1 = i_c;
+            } else {
+                _nodes[c.parent].child2 = i_c;
+            }
+        } else {
+            _root = i_c;
+        }
+
+        // Rotate the taller grandchild up with C
+        if (f.height > g.height) {
+            c.child2 = i_f;
+            a.child2 = i_g;
+            g.parent = i_a;
+            a.aabb = b.aabb.merged(g.aabb);
+            c.aabb = a.aabb.merged(f.aabb);
+            a.height = 1 + std::max(b.height, g.height);
+            c.height = 1 + std::max(a.height, f.height);
+        } else {
+            c.child2 = i_g;
+            a.child2 = i_f;
+            f.parent = i_a;
+            a.aabb = b.aabb.merged(f.aabb);
+            c.aabb = a.aabb.merged(g.aabb);
+            a.height = 1 + std::max(b.height, f.height);
+            c.height = 1 + std::max(a.height, g.height);
+        }
+
+        return i_c;
+    }
+
+    // Rotate B up
+    if (balance_factor < -1) {
+        int i_d = b.child1;
+        int i_e = b.child2;
+        Node& d = _nodes[i_d];
+        Node& e = _nodes[i_e];
+
+        // Swap A and B
+        b.child1 = i_a;
+        b.parent = a.parent;
+        a.parent = i_b;
+
+        // A's old parent should point to B
+        if (b.parent != NULL_NODE) {
+            if (_nodes[b.parent].child1 == i_a) {
+                _nodes[b.parent].child1 = i_b;
+            } else {
+                _nodes[b.parent].child2 = i_b;
+            }
+        } else {
+            _root = i_b;
+        }
+
+        // Rotate the taller grandchild up with B
+        if (d.height > e.height) {
+            b.child2 = i_d;
+            a.child1 = i_e;
+            e.parent = i_a;
+            a.aabb = c.aabb.merged(e.aabb);
+            b.aabb = a.aabb.merged(d.aabb);
+            a.height = 1 + std::max(c.height, e.height);
+            b.height = 1 + std::max(a.height, d.height);
+        } else {
+            b.child2 = i_e;
+            a.child1 = i_d;
+            d.parent = i_a;
+            a.aabb = c.aabb.merged(d.aabb);
+            b.aabb = a.aabb.merged(e.aabb);
+            a.height = 1 + std::max(c.height, d.height);
+            b.height = 1 + std::max(a.height, e.height);
+        }
+
+        return i_b;
+    }
+
+    return i_a;
+}
+
+}  // namespace engine::physics
@@ -0,0 +1,68 @@
+#include <engine/physics/height_field.hpp>
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+
+namespace engine::physics {
+
+HeightField::HeightField(uint32_t columns, uint32_t rows, float cell_size, std::vector<float> heights)
+    : _columns(columns), _rows(rows), _cell_size(cell_size), _heights(std::move(heights)) {
+    assert(_heights.size() == size_t(_columns) * _rows);
+    if (columns < 2 || rows < 2 || _heights.size() != size_t(_columns) * _rows) {
+        _columns = 0;
+        _rows = 0;
+        _heights.clear();
+        return;
+    }
+
+    std::vector<AABB> cell_bounds(cell_count());
+    for (uint32_t row = 0; row + 1 < _rows; ++row) {
+        for (uint32_t column = 0; column + 1 < _columns; ++column) {
+            float h00 = height(column, row);
+            float h10 = height(column + 1, row);
+            float h01 = height(column, row + 1);
+            float h11 = height(column + 1, row + 1);
+
+            cell_bounds[row * (_columns - 1) + column] = AABB(
+                glm::vec3(column * _cell_size, std::min({h00, h10, h01, h11}), row * _cell_size),
+                glm::vec3((column + 1) * _cell_size, std::max({h00, h10, h01, h11}), (row + 1) * _cell_size));
+        }
+    }
+    _bvh.build(cell_bounds);
+}
+
+float HeightField::height_at(float x, float z) const {
+    if (_columns < 2 || _rows < 2) return 0.0f;
+
+    float fx = glm::clamp(x / _cell_size, 0.0f, static_cast<float>(_columns - 1));
+    float fz = glm::clamp(z / _cell_size, 0.0f, static_cast<float>(_rows - 1));
+    uint32_t column = std::min(static_cast<uint32_t>(fx), _columns - 2);
+    uint32_t row = std::min(static_cast<uint32_t>(fz), _rows - 2);
+    fx -= static_cast<float>(column);
+    fz -= static_cast<float>(row);
+
+    // Same diagonal as cell_triangles: (0, 1) to (1, 0)
+    if (fx + fz <= 1.0f) {
+        float h00 = height(column, row);
+        return h00 + fx * (height(column + 1, row) - h00) + fz * (height(column, row + 1) - h00);
+    }
+    float h11 = height(column + 1, row + 1);
+    return h11 + (1.0f - fx) * (height(column, row + 1) - h11) + (1.0f - fz) * (height(column + 1, row) - h11);
+}
+
+void HeightField::cell_triangles(uint32_t cell, Triangle& first, Triangle& second) const {
+    uint32_t column = cell % (_columns - 1);
+    uint32_t row = cell / (_columns - 1);
+
+    glm::vec3 p00 = sample(column, row);
+    glm::vec3 p10 = sample(column + 1, row);
+    glm::vec3 p01 = sample(column, row + 1);
+    glm::vec3 p11 = sample(column + 1, row + 1);
+
+    // Both wound so their normals face +Y
+    first = Triangle{p00, p01, p10};
+    second = Triangle{p10, p01, p11};
+}
+
+}  // namespace engine::physics
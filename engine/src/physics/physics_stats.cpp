@@ -0,0 +1,43 @@
+#include <engine/physics/physics_stats.hpp>
+
+namespace engine::physics {
+
+const char* phase_name(PhysicsPhase phase) {
+    switch (phase) {
+        case PhysicsPhase::Integrate:    return "integrate";
+        case PhysicsPhase::BroadPhase:   return "broad_phase";
+        case PhysicsPhase::NarrowPhase:  return "narrow_phase";
+        case PhysicsPhase::Solve:        return "solve";
+        case PhysicsPhase::QueryTree:    return "query_tree";
+        case PhysicsPhase::Sleep:        return "sleep";
+    }
+    return "unknown";
+}
+
+void write_stats_csv_header(std::FILE* file) {
+    std::fprintf(file, "steps");
+    for (int phase = 0; phase < PHYSICS_PHASE_COUNT; ++phase) {
+        std::fprintf(file, ",%s_ms", phase_name(static_cast<PhysicsPhase>(phase)));
+    }
+    std::fprintf(file, ",total_ms,candidate_pairs,touching_pairs,hit_ratio,contacts,islands,"
+                       "bodies,static_bodies,sleeping_bodies\n");
+}
+
+void write_stats_csv_row(std::FILE* file, const PhysicsStats& stats) {
+    double per_step = stats.steps > 0 ? 1.0 / stats.steps : 0.0;
+
+    std::fprintf(file, "%d", stats.steps);
+    for (int phase = 0; phase < PHYSICS_PHASE_COUNT; ++phase) {
+        std::fprintf(file, ",%.4f", stats.phase_ms[phase] * per_step);
+    }
+    std::fprintf(file, ",%.4f,%llu,%llu,%.4f,%llu,%llu,%u,%u,%u\n",
+                 stats.total_ms * per_step,
+                 static_cast<unsigned long long>(stats.candidate_pairs),
+                 static_cast<unsigned long long>(stats.touching_pairs),
+                 stats.hit_ratio(),
+                 static_cast<unsigned long long>(stats.contacts),
+                 static_cast<unsigned long long>(stats.islands),
+                 stats.body_count, stats.static_body_count, stats.sleeping_body_count);
+}
+
+}  // namespace engine::physics
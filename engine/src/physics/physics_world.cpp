@@ -1,212 +1,989 @@
 #include <engine/physics/physics_world.hpp>
 
 #include <algorithm>
+#include <chrono>
 #include <cmath>
+#include <cstring>
+#include <limits>
 
 namespace engine::physics {
 
-PhysicsWorld::PhysicsWorld() = default;
+namespace {
+
+// A cached impulse is only reused while the contact normal stays within
+// about 25 degrees of last step's
+constexpr float WARM_START_MIN_COS = 0.9f;
+
+// 64-bit FNV-1a
+constexpr uint64_t FNV_OFFSET_BASIS = 14695981039346656037ull;
+constexpr uint64_t FNV_PRIME = 1099511628211ull;
+
+void hash_bits(uint64_t& hash, uint32_t bits) {
+    for (int byte = 0; byte < 4; ++byte) {
+        hash ^= (bits >> (byte * 8)) & 0xFFu;
+        hash *= FNV_PRIME;
+    }
+}
+
+// Hashes the bit pattern, so -0.0 and 0.0 (or two NaNs) count as different
+void hash_float(uint64_t& hash, float value) {
+    uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    hash_bits(hash, bits);
+}
+
+// Adds the lifetime of a scope to a profiler time (does nothing for null)
+class PhaseTimer {
+public:
+    explicit PhaseTimer(double* target) : _target(target) {
+        if (_target) _start = std::chrono::steady_clock::now();
+    }
+    ~PhaseTimer() {
+        if (!_target) return;
+        std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - _start;
+        *_target += elapsed.count();
+    }
+
+    PhaseTimer(const PhaseTimer&) = delete;
+    PhaseTimer& operator=(const PhaseTimer&) = delete;
+
+private:
+    double* _target;
+    std::chrono::steady_clock::time_point _start;
+};
+
+}  // namespace
+
+PhysicsWorld::PhysicsWorld()
+    : _broad_phase(create_broad_phase(BroadPhaseType::SpatialHash)) {}
+
+PhysicsWorld::~PhysicsWorld() {
+    clear_bodies();
+}
 
 void PhysicsWorld::update(float delta) {
+    _interpolation_alpha = 1.0f;
+    _contact_events.clear();
+    begin_stats();
+    simulate(delta);
+}
+
+int PhysicsWorld::step(float frame_delta) {
+    _contact_events.clear();
+
+    int steps = _timestep.advance(frame_delta);
+    if (steps > 0) begin_stats();
+    for (int i = 0; i < steps; ++i) {
+        _store.save_previous_positions();
+        simulate(_timestep.step());
+    }
+
+    _interpolation_alpha = _timestep.alpha();
+    return steps;
+}
+
+void PhysicsWorld::set_fixed_timestep(float step, int max_substeps) {
+    _timestep.set_step(step);
+    _timestep.set_max_substeps(max_substeps);
+    _timestep.reset();
+}
+
+glm::vec3 PhysicsWorld::interpolated_position(uint32_t index) const {
+    return glm::mix(_store.previous_position(index), _store.position(index), _interpolation_alpha);
+}
+
+void PhysicsWorld::simulate(float delta) {
+    PhaseTimer total_timer(is_profiling_enabled() ? &_stats.total_ms : nullptr);
+
     // Step 1: Integrate velocities and positions
-    integrate(delta);
+    {
+        PhaseTimer timer(phase_time(PhysicsPhase::Integrate));
+        integrate(delta);
+    }
 
-    // Step 2: Detect and resolve collisions
+    // Step 2: Detect and resolve collisions (timed phase by phase inside)
     detect_and_resolve_collisions();
+
+    // Step 3: Refit query tree to the resolved positions
+    {
+        PhaseTimer timer(phase_time(PhysicsPhase::QueryTree));
+        update_query_tree(delta);
+    }
+
+    // Step 4: Put resting islands to sleep
+    {
+        PhaseTimer timer(phase_time(PhysicsPhase::Sleep));
+        update_sleep(delta);
+    }
+
+    end_step_stats();
+}
+
+void PhysicsWorld::begin_stats() {
+    if (is_profiling_enabled()) _stats = PhysicsStats();
+}
+
+void PhysicsWorld::end_step_stats() {
+    if (!is_profiling_enabled()) return;
+
+    ++_stats.steps;
+    _stats.contacts += _contacts.size();
+    _stats.body_count = static_cast<uint32_t>(_store.size());
+    _stats.sleeping_body_count = static_cast<uint32_t>(_sleeping_count);
+    _stats.static_body_count = 0;
+    for (uint32_t i = 0; i < _store.size(); ++i) {
+        if (_store.is_static(i)) ++_stats.static_body_count;
+    }
 }
 
 void PhysicsWorld::set_gravity(glm::vec3 gravity) {
     _gravity = gravity;
+    wake_all();
 }
 
 void PhysicsWorld::add_body(RigidBody* body) {
-    if (body && std::find(_bodies.begin(), _bodies.end(), body) == _bodies.end()) {
-        _bodies.push_back(body);
+    if (!body || body->_world == this) return;
+
+    if (body->_world) {
+        body->_world->remove_body(body);
+    }
+
+    body->_handle = _store.create(body->_local, body);
+    body->_world = this;
+    if (_store.is_sleeping(_store.dense_index(body->_handle))) ++_sleeping_count;
+
+    if (!body->_local.shape.empty()) {
+        uint32_t index = _store.dense_index(body->_handle);
+        _store.tree_proxies[index] = _query_tree.create_proxy(
+            compute_aabb(_store.shapes[index], _store.position(index)), body->_handle.slot);
     }
+    _broad_phase->add_proxy(_store.dense_index(body->_handle));
+    _proxies_dirty = true;
 }
 
 void PhysicsWorld::remove_body(RigidBody* body) {
-    auto it = std::find(_bodies.begin(), _bodies.end(), body);
-    if (it != _bodies.end()) {
-        _bodies.erase(it);
+    if (!body || body->_world != this) return;
+
+    uint32_t index = _store.dense_index(body->_handle);
+    int tree_proxy = _store.tree_proxies[index];
+    if (tree_proxy != DynamicAABBTree::NULL_NODE) {
+        // Bodies resting on this one have nothing to hold them up any more
+        _query_tree.query(_query_tree.fat_aabb(tree_proxy), [&](int proxy) {
+            wake_body(_store.dense_index_of_slot(_query_tree.user_id(proxy)));
+            return true;
+        });
+        _query_tree.destroy_proxy(tree_proxy);
     }
+    _contact_cache.remove_slot(body->_handle.slot);
+    if (_store.is_sleeping(index)) --_sleeping_count;
+
+    // End the body's trigger overlaps (its handle goes stale right after)
+    auto removed = std::remove_if(_trigger_overlaps.begin(), _trigger_overlaps.end(),
+        [&](const TriggerOverlap& overlap) {
+            if (overlap.trigger != body->_handle && overlap.other != body->_handle) return false;
+            _trigger_events.push_back(TriggerEvent{TriggerEventType::Exit, overlap.trigger, overlap.other});
+            return true;
+        });
+    _trigger_overlaps.erase(removed, _trigger_overlaps.end());
+
+    // Hand the final state back to the (now detached) body; the last body
+    // moves into its index
+    uint32_t last = static_cast<uint32_t>(_store.size()) - 1;
+    body->_local = _store.destroy(body->_handle);
+    body->_world = nullptr;
+    body->_handle = BodyHandle{};
+    _broad_phase->remove_proxy(index, last);
+    _proxies_dirty = true;
 }
 
 void PhysicsWorld::clear_bodies() {
-    _bodies.clear();
+    for (uint32_t i = 0; i < _store.size(); ++i) {
+        RigidBody* body = _store.owners[i];
+        body->_local = _store.get_state(i);
+        body->_world = nullptr;
+        body->_handle = BodyHandle{};
+    }
+
+    _store.clear();
+    _query_tree.clear();
+    _contact_cache.clear();
+    _trigger_overlaps.clear();
+    _trigger_events.clear();
+    _broad_phase->reset();
+    _proxies_dirty = true;
+    _sleeping_count = 0;
 }
 
-std::vector<RigidBody*> PhysicsWorld::query_sphere(glm::vec3 center, float radius) {
-    std::vector<RigidBody*> results;
+void PhysicsWorld::rebind_body(RigidBody* body) {
+    _store.owners[_store.dense_index(body->_handle)] = body;
+}
+
+void PhysicsWorld::wake_body(uint32_t index) {
+    if (!_store.is_sleeping(index)) return;
+
+    _store.set_flags(index, _store.flags[index] & ~BODY_SLEEPING);
+    _store.sleep_time[index] = 0.0f;
+    --_sleeping_count;
+}
 
-    SphereShape query_sphere(radius);
+void PhysicsWorld::wake_all() {
+    for (uint32_t i = 0; i < _store.size(); ++i) {
+        wake_body(i);
+    }
+}
+
+void PhysicsWorld::set_sleeping_enabled(bool enabled) {
+    _sleeping_enabled = enabled;
+    if (!enabled) wake_all();
+}
 
-    for (RigidBody* body : _bodies) {
-        if (!body->shape) continue;
+void PhysicsWorld::on_shape_changed(RigidBody* body) {
+    uint32_t index = _store.dense_index(body->_handle);
+    const CollisionShape& shape = _store.shapes[index];
 
-        auto result = test_collision(query_sphere, center, *body->shape, body->position);
-        if (result.collided) {
-            results.push_back(body);
+    // Refit right away so queries before the next update see the new bounds
+    int& proxy = _store.tree_proxies[index];
+    if (shape.empty()) {
+        if (proxy != DynamicAABBTree::NULL_NODE) {
+            _query_tree.destroy_proxy(proxy);
+            proxy = DynamicAABBTree::NULL_NODE;
         }
+    } else if (proxy == DynamicAABBTree::NULL_NODE) {
+        proxy = _query_tree.create_proxy(compute_aabb(shape, _store.position(index)), body->_handle.slot);
+    } else {
+        _query_tree.move_proxy(proxy, compute_aabb(shape, _store.position(index)), glm::vec3(0.0f));
     }
+}
+
+void PhysicsWorld::on_position_changed(RigidBody* body) {
+    uint32_t index = _store.dense_index(body->_handle);
+    int proxy = _store.tree_proxies[index];
+    if (proxy == DynamicAABBTree::NULL_NODE) return;
+
+    // Teleports and kinematic moves: only re-inserted once out of the fat box
+    _query_tree.move_proxy(proxy, compute_aabb(_store.shapes[index], _store.position(index)), glm::vec3(0.0f));
+}
 
+std::vector<RigidBody*> PhysicsWorld::query_sphere(glm::vec3 center, float radius, uint32_t mask) {
+    std::vector<RigidBody*> results;
+    query_sphere(center, radius, results, mask);
     return results;
 }
 
-std::vector<RigidBody*> PhysicsWorld::query_aabb(glm::vec3 min, glm::vec3 max) {
+std::vector<RigidBody*> PhysicsWorld::query_aabb(glm::vec3 min, glm::vec3 max, uint32_t mask) {
     std::vector<RigidBody*> results;
+    query_aabb(min, max, results, mask);
+    return results;
+}
 
-    glm::vec3 center = (min + max) * 0.5f;
-    glm::vec3 half_extents = (max - min) * 0.5f;
-    AABBShape query_aabb(half_extents);
+size_t PhysicsWorld::query_sphere(glm::vec3 center, float radius, std::vector<RigidBody*>& results,
+                                  uint32_t mask) const {
+    results.clear();
+    return visit_sphere(center, radius, [&](RigidBody* body) {
+        results.push_back(body);
+        return true;
+    }, mask);
+}
 
-    for (RigidBody* body : _bodies) {
-        if (!body->shape) continue;
+size_t PhysicsWorld::query_aabb(glm::vec3 min, glm::vec3 max, std::vector<RigidBody*>& results,
+                                uint32_t mask) const {
+    results.clear();
+    return visit_aabb(min, max, [&](RigidBody* body) {
+        results.push_back(body);
+        return true;
+    }, mask);
+}
 
-        auto result = test_collision(query_aabb, center, *body->shape, body->position);
-        if (result.collided) {
-            results.push_back(body);
+size_t PhysicsWorld::query_candidates(const AABB& bounds, std::vector<uint32_t>& indices,
+                                      uint32_t mask) const {
+    indices.clear();
+    _query_tree.query(bounds, [&](int proxy) {
+        uint32_t index = _store.dense_index_of_slot(_query_tree.user_id(proxy));
+        if ((_store.collision_layers[index] & mask) != 0) {
+            indices.push_back(index);
         }
-    }
+        return true;
+    });
+    return indices.size();
+}
 
-    return results;
+void PhysicsWorld::query_candidates_many(const AABB* bounds, const uint32_t* masks, uint32_t count,
+                                         std::vector<uint32_t>& offsets, std::vector<uint32_t>& indices) {
+    _candidate_boxes.clear();
+    _candidate_hits.clear();
+    offsets.assign(count + 1, 0);
+
+    _query_tree.query_many(bounds, count, _box_lists, [&](int proxy, uint32_t box) {
+        uint32_t index = _store.dense_index_of_slot(_query_tree.user_id(proxy));
+        if ((_store.collision_layers[index] & masks[box]) != 0) {
+            _candidate_boxes.push_back(box);
+            _candidate_hits.push_back(index);
+            ++offsets[box + 1];
+        }
+    });
+
+    // Group the hits by box, keeping each box's tree order
+    for (uint32_t box = 0; box < count; ++box) {
+        offsets[box + 1] += offsets[box];
+    }
+    indices.resize(_candidate_hits.size());
+    _box_lists.assign(offsets.begin(), offsets.end() - 1);  // Write cursor per box
+    for (size_t i = 0; i < _candidate_hits.size(); ++i) {
+        indices[_box_lists[_candidate_boxes[i]]++] = _candidate_hits[i];
+    }
 }
 
-bool PhysicsWorld::raycast(glm::vec3 origin, glm::vec3 direction, float max_dist, RaycastHit& hit) {
+bool PhysicsWorld::raycast(glm::vec3 origin, glm::vec3 direction, float max_dist, RaycastHit& hit,
+                           uint32_t mask) {
     direction = glm::normalize(direction);
     hit = RaycastHit{};
 
-    float closest_dist = max_dist;
     bool found = false;
 
-    for (RigidBody* body : _bodies) {
-        if (!body->shape) continue;
+    _query_tree.raycast(origin, direction, max_dist, [&](int proxy, float closest_dist) {
+        uint32_t index = _store.dense_index_of_slot(_query_tree.user_id(proxy));
 
-        // Simple ray-shape intersection based on shape type
-        glm::vec3 to_body = body->world_position() - origin;
-        float t = glm::dot(to_body, direction);
+        RaycastHit body_hit;
+        if (raycast_body(index, origin, direction, closest_dist, mask, body_hit)) {
+            hit = body_hit;
+            found = true;
+            return body_hit.distance;  // Clip the ray to the closest hit
+        }
+        return closest_dist;
+    });
 
-        if (t < 0 || t > closest_dist) continue;
+    return found;
+}
 
-        glm::vec3 closest_point = origin + direction * t;
-        float dist_to_center = glm::length(body->world_position() - closest_point);
+size_t PhysicsWorld::raycast_many(const std::vector<Ray>& rays, std::vector<RaycastHit>& hits) {
+    const uint32_t ray_count = static_cast<uint32_t>(rays.size());
+
+    hits.assign(ray_count, RaycastHit{});
+    _ray_origins.resize(ray_count);
+    _ray_directions.resize(ray_count);
+    _ray_inv_directions.resize(ray_count);
+    _ray_max_dists.resize(ray_count);
+    _ray_masks.resize(ray_count);
+
+    for (uint32_t i = 0; i < ray_count; ++i) {
+        _ray_origins[i] = rays[i].origin;
+        _ray_directions[i] = glm::normalize(rays[i].direction);
+        _ray_inv_directions[i] = 1.0f / _ray_directions[i];
+        _ray_max_dists[i] = rays[i].max_dist;
+        _ray_masks[i] = rays[i].mask;
+    }
 
-        // Get effective radius based on shape
-        float effective_radius = 0.0f;
-        if (body->shape->type == ShapeType::Sphere) {
-            effective_radius = static_cast<SphereShape*>(body->shape.get())->radius;
-        } else if (body->shape->type == ShapeType::AABB) {
-            // Approximate AABB as sphere for raycast
-            auto* aabb = static_cast<AABBShape*>(body->shape.get());
-            effective_radius = glm::length(aabb->half_extents);
-        } else if (body->shape->type == ShapeType::Capsule) {
-            effective_radius = static_cast<CapsuleShape*>(body->shape.get())->radius;
-        }
+    _query_tree.raycast_many(_ray_origins.data(), _ray_inv_directions.data(), _ray_max_dists.data(),
+                             ray_count, _ray_lists, [&](int proxy, uint32_t ray, float closest_dist) {
+        uint32_t index = _store.dense_index_of_slot(_query_tree.user_id(proxy));
 
-        if (dist_to_center <= effective_radius) {
-            // Calculate actual hit point
-            float half_chord = std::sqrt(effective_radius * effective_radius - dist_to_center * dist_to_center);
-            float hit_t = t - half_chord;
-
-            if (hit_t > 0 && hit_t < closest_dist) {
-                closest_dist = hit_t;
-                hit.body = body;
-                hit.distance = hit_t;
-                hit.point = origin + direction * hit_t;
-                hit.normal = glm::normalize(hit.point - body->world_position());
-                found = true;
-            }
+        RaycastHit body_hit;
+        if (raycast_body(index, _ray_origins[ray], _ray_directions[ray], closest_dist,
+                         _ray_masks[ray], body_hit)) {
+            hits[ray] = body_hit;
+            return body_hit.distance;  // Clip this ray to its closest hit
         }
+        return closest_dist;
+    });
+
+    size_t hit_count = 0;
+    for (const RaycastHit& hit : hits) {
+        if (hit.body) ++hit_count;
     }
+    return hit_count;
+}
 
-    return found;
+bool PhysicsWorld::sweep_sphere(glm::vec3 start, float radius, glm::vec3 motion, SweepHit& hit,
+                                uint32_t mask, const BodyFilter& filter) {
+    hit = SweepHit{};
+
+    // Candidates overlap the bounds of the whole swept volume
+    glm::vec3 end = start + motion;
+    AABB swept_bounds(glm::min(start, end) - glm::vec3(radius), glm::max(start, end) + glm::vec3(radius));
+
+    float best_time = 2.0f;
+
+    _query_tree.query(swept_bounds, [&](int proxy) {
+        uint32_t index = _store.dense_index_of_slot(_query_tree.user_id(proxy));
+        if ((_store.collision_layers[index] & mask) == 0) return true;
+        RigidBody* body = _store.owners[index];
+
+        auto result = engine::physics::sweep_sphere(radius, start, motion, _store.shapes[index], _store.position(index));
+        if (result.hit && result.time < best_time && (!filter || filter(body))) {
+            best_time = result.time;
+            hit.body = body;
+            hit.time = result.time;
+            hit.point = result.contact_point;
+            hit.normal = result.normal;
+        }
+        return true;
+    });
+
+    return hit.body != nullptr;
+}
+
+bool PhysicsWorld::raycast_body(uint32_t index, glm::vec3 origin, glm::vec3 direction,
+                                float max_dist, uint32_t mask, RaycastHit& hit) const {
+    if ((_store.collision_layers[index] & mask) == 0) return false;
+
+    auto result = raycast_shape(origin, direction, max_dist, _store.shapes[index], _store.position(index));
+    if (!result.hit) return false;
+
+    hit.body = _store.owners[index];
+    hit.distance = result.distance;
+    hit.point = origin + direction * result.distance;
+    hit.normal = result.normal;
+    return true;
+}
+
+RigidBody* PhysicsWorld::body(BodyHandle handle) const {
+    if (!_store.contains(handle)) return nullptr;
+    return _store.owners[_store.dense_index(handle)];
 }
 
 void PhysicsWorld::set_collision_callback(CollisionCallback callback) {
     _collision_callback = std::move(callback);
 }
 
+void PhysicsWorld::set_broad_phase(BroadPhaseType type) {
+    set_broad_phase(create_broad_phase(type));
+}
+
+void PhysicsWorld::set_broad_phase(std::unique_ptr<BroadPhase> broad_phase) {
+    if (!broad_phase) return;
+    _broad_phase = std::move(broad_phase);
+}
+
+void PhysicsWorld::set_solver_iterations(int iterations) {
+    _solver_iterations = std::max(iterations, 1);
+}
+
+void PhysicsWorld::set_thread_count(unsigned count) {
+    if (count == thread_count()) return;
+
+    if (count <= 1) {
+        _task_pool.reset();
+    } else {
+        _task_pool = std::make_unique<TaskPool>(count);
+    }
+}
+
+void PhysicsWorld::set_profiling_enabled(bool enabled) {
+    _profiling = enabled;
+    _stats = PhysicsStats();
+}
+
+uint64_t PhysicsWorld::state_hash() const {
+    uint64_t hash = FNV_OFFSET_BASIS;
+    for (uint32_t i = 0; i < _store.size(); ++i) {
+        hash_bits(hash, _store.slots[i]);
+        hash_float(hash, _store.pos_x[i]);
+        hash_float(hash, _store.pos_y[i]);
+        hash_float(hash, _store.pos_z[i]);
+        hash_float(hash, _store.vel_x[i]);
+        hash_float(hash, _store.vel_y[i]);
+        hash_float(hash, _store.vel_z[i]);
+    }
+    return hash;
+}
+
 void PhysicsWorld::integrate(float delta) {
-    for (RigidBody* body : _bodies) {
-        body->integrate(delta, _gravity);
+    _store.integrate(delta, _gravity);
+}
+
+void PhysicsWorld::update_proxies() {
+    _proxies.resize(_store.size());
+    for (uint32_t i = 0; i < _store.size(); ++i) {
+        const CollisionShape& shape = _store.shapes[i];
+        BroadPhaseProxy& proxy = _proxies[i];
+
+        // A body that was already asleep last step hasn't moved since
+        bool was_sleeping = proxy.is_sleeping;
+        bool was_enabled = proxy.enabled;
+        proxy.enabled = !shape.empty();
+        proxy.is_static = _store.is_static(i);
+        proxy.is_sleeping = _store.is_sleeping(i);
+        proxy.is_moved = false;
+        proxy.collision_layer = _store.collision_layers[i];
+        proxy.collision_mask = _store.collision_masks[i];
+        if (proxy.enabled && !(was_sleeping && proxy.is_sleeping && !_proxies_dirty)) {
+            AABB bounds = compute_aabb(shape, _store.position(i));
+
+            // Static bodies moved by hand (character capsules) pair with and
+            // wake sleeping bodies. Indices shift when the body set changes,
+            // so such a step can't tell and leaves it for the next one.
+            if (proxy.is_static && was_enabled && !_proxies_dirty) {
+                proxy.is_moved = bounds.min != proxy.bounds.min || bounds.max != proxy.bounds.max;
+            }
+            proxy.bounds = bounds;
+        }
     }
+    _proxies_dirty = false;
 }
 
-void PhysicsWorld::detect_and_resolve_collisions() {
-    // Simple O(n^2) broad phase (can be optimized with spatial partitioning later)
-    for (size_t i = 0; i < _bodies.size(); ++i) {
-        for (size_t j = i + 1; j < _bodies.size(); ++j) {
-            RigidBody* a = _bodies[i];
-            RigidBody* b = _bodies[j];
+void PhysicsWorld::update_query_tree(float delta) {
+    for (uint32_t i = 0; i < _store.size(); ++i) {
+        const CollisionShape& shape = _store.shapes[i];
+        int& proxy = _store.tree_proxies[i];
+
+        // Sleeping bodies were refit in the step they fell asleep
+        if (shape.empty() || (_store.is_sleeping(i) && proxy != DynamicAABBTree::NULL_NODE)) continue;
+
+        AABB bounds = compute_aabb(shape, _store.position(i));
+        if (proxy == DynamicAABBTree::NULL_NODE) {
+            proxy = _query_tree.create_proxy(bounds, _store.slots[i]);
+        } else {
+            _query_tree.move_proxy(proxy, bounds, _store.velocity(i) * delta);
+        }
+    }
+}
 
-            // Skip if both are static
-            if (a->is_static && b->is_static) continue;
+void PhysicsWorld::detect_and_resolve_collisions() {
+    if (_task_pool) {
+        detect_and_resolve_parallel();
+        return;
+    }
 
-            // Skip if no shapes
-            if (!a->shape || !b->shape) continue;
+    // Broad phase: collect candidate pairs with overlapping bounds
+    {
+        PhaseTimer timer(phase_time(PhysicsPhase::BroadPhase));
+        update_proxies();
+        _pairs.clear();
+        _broad_phase->find_pairs(_proxies, _pairs);
 
-            auto result = test_collision(*a->shape, a->position, *b->shape, b->position);
+        if (_deterministic) {
+            std::sort(_pairs.begin(), _pairs.end());
+        }
+    }
 
+    // Narrow phase
+    {
+        PhaseTimer timer(phase_time(PhysicsPhase::NarrowPhase));
+        begin_narrow_phase();
+        for (const BodyPair& pair : _pairs) {
+            auto result = test_collision(_store.shapes[pair.a], _store.position(pair.a),
+                                         _store.shapes[pair.b], _store.position(pair.b));
             if (result.collided) {
-                // Call collision callback
-                if (_collision_callback) {
-                    _collision_callback(a, b, result);
-                }
+                add_narrow_result(pair, result);
+            }
+        }
+        end_narrow_phase();
+    }
+
+    // Solve every contact as a single island, in pair order
+    PhaseTimer timer(phase_time(PhysicsPhase::Solve));
+    if (is_profiling_enabled()) {
+        _stats.candidate_pairs += _pairs.size();
+        _stats.islands += _contacts.empty() ? 0 : 1;
+    }
+    _island_contacts.resize(_contacts.size());
+    for (size_t i = 0; i < _contacts.size(); ++i) {
+        _island_contacts[i] = static_cast<uint32_t>(i);
+    }
+    _island_start.assign({0, static_cast<uint32_t>(_contacts.size())});
+
+    solve_island(0);
+    store_contacts();
+}
+
+void PhysicsWorld::detect_and_resolve_parallel() {
+    // Broad phase (pairs are sorted so the event order doesn't depend on the
+    // broad phase or on how the narrow phase was split)
+    {
+        PhaseTimer timer(phase_time(PhysicsPhase::BroadPhase));
+        update_proxies();
+        _pairs.clear();
+        _broad_phase->find_pairs(_proxies, _pairs);
+        std::sort(_pairs.begin(), _pairs.end());
+    }
 
-                // Skip resolution if either is a trigger
-                if (a->is_trigger || b->is_trigger) continue;
+    {
+        PhaseTimer timer(phase_time(PhysicsPhase::NarrowPhase));
 
-                resolve_collision(a, b, result);
+        // Narrow phase: each worker writes its own range of results
+        _narrow_results.resize(_pairs.size());
+        _task_pool->parallel_for(_pairs.size(), 64, [this](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i) {
+                const BodyPair& pair = _pairs[i];
+                _narrow_results[i] = test_collision(_store.shapes[pair.a], _store.position(pair.a),
+                                                    _store.shapes[pair.b], _store.position(pair.b));
+            }
+        });
+
+        // Events and contacts on the calling thread, in pair order
+        begin_narrow_phase();
+        for (size_t i = 0; i < _pairs.size(); ++i) {
+            if (_narrow_results[i].collided) {
+                add_narrow_result(_pairs[i], _narrow_results[i]);
             }
         }
+        end_narrow_phase();
+    }
+
+    PhaseTimer timer(phase_time(PhysicsPhase::Solve));
+    if (is_profiling_enabled()) _stats.candidate_pairs += _pairs.size();
+
+    if (!_contacts.empty()) {
+        // Islands never share a dynamic body, so each one can be solved on its
+        // own worker. Contacts within an island keep their pair order.
+        build_islands();
+
+        size_t island_count = _island_start.size() - 1;
+        if (is_profiling_enabled()) _stats.islands += island_count;
+        _task_pool->parallel_for(island_count, 1, [this](size_t begin, size_t end) {
+            for (size_t island = begin; island < end; ++island) {
+                solve_island(island);
+            }
+        });
     }
+
+    store_contacts();
 }
 
-void PhysicsWorld::resolve_collision(RigidBody* a, RigidBody* b, const CollisionResult& result) {
-    // Calculate inverse masses
-    float inv_mass_a = a->is_static ? 0.0f : a->inv_mass;
-    float inv_mass_b = b->is_static ? 0.0f : b->inv_mass;
-    float total_inv_mass = inv_mass_a + inv_mass_b;
+void PhysicsWorld::begin_narrow_phase() {
+    _contacts.clear();
+    _new_trigger_overlaps.clear();
+    _step_events_begin = _contact_events.size();
+}
 
-    if (total_inv_mass <= 0.0f) return;  // Both static
+void PhysicsWorld::add_narrow_result(const BodyPair& pair, const CollisionResult& result) {
+    if (is_profiling_enabled()) ++_stats.touching_pairs;
 
-    // Position correction (separate the bodies)
-    const float correction_percent = 0.8f;  // Penetration percentage to correct
-    const float slop = 0.01f;  // Small allowance to prevent jitter
+    // Trigger overlaps are tracked, never resolved
+    if (_store.is_trigger(pair.a) || _store.is_trigger(pair.b)) {
+        add_trigger_overlap(pair.a, pair.b);
+        return;
+    }
+
+    ContactEvent event;
+    event.a = _store.handle(pair.a);
+    event.b = _store.handle(pair.b);
+    event.normal = result.normal;
+    event.penetration = result.penetration;
+    event.point = result.contact_point;
+    _contact_events.push_back(event);
+
+    wake_touched(pair.a, pair.b);
+    _contacts.push_back(Contact{pair.a, pair.b, result});
+}
+
+void PhysicsWorld::end_narrow_phase() {
+    update_triggers();
+
+    // The callback is an adapter over this step's contact events, run before
+    // any contact is resolved
+    if (!_collision_callback) return;
+
+    for (size_t i = _step_events_begin; i < _contact_events.size(); ++i) {
+        const ContactEvent& event = _contact_events[i];
+
+        CollisionResult result;
+        result.collided = true;
+        result.normal = event.normal;
+        result.penetration = event.penetration;
+        result.contact_point = event.point;
+        _collision_callback(body(event.a), body(event.b), result);
+    }
+}
+
+uint32_t PhysicsWorld::find_island_root(uint32_t index) {
+    while (_island_parent[index] != index) {
+        _island_parent[index] = _island_parent[_island_parent[index]];  // Path halving
+        index = _island_parent[index];
+    }
+    return index;
+}
+
+void PhysicsWorld::union_contact_islands() {
+    const uint32_t body_count = _store.size();
+    _island_parent.resize(body_count);
+    for (uint32_t i = 0; i < body_count; ++i) {
+        _island_parent[i] = i;
+    }
+
+    // Union touching dynamic bodies (static bodies are never written by the
+    // solver, so islands may share them)
+    for (const Contact& contact : _contacts) {
+        if (_store.inv_mass[contact.a] <= 0.0f || _store.inv_mass[contact.b] <= 0.0f) continue;
+
+        uint32_t root_a = find_island_root(contact.a);
+        uint32_t root_b = find_island_root(contact.b);
+        if (root_a != root_b) {
+            // Lower index wins so roots don't depend on anything but pair order
+            if (root_b < root_a) std::swap(root_a, root_b);
+            _island_parent[root_b] = root_a;
+        }
+    }
+}
+
+void PhysicsWorld::build_islands() {
+    const uint32_t body_count = _store.size();
+    const uint32_t none = std::numeric_limits<uint32_t>::max();
+
+    union_contact_islands();
+
+    // Number islands in order of first contact
+    _island_ids.assign(body_count, none);
+    _contact_islands.resize(_contacts.size());
+    _island_start.clear();
+
+    for (size_t i = 0; i < _contacts.size(); ++i) {
+        const Contact& contact = _contacts[i];
+        uint32_t body = _store.inv_mass[contact.a] > 0.0f ? contact.a : contact.b;
+        uint32_t root = find_island_root(body);
+
+        if (_island_ids[root] == none) {
+            _island_ids[root] = static_cast<uint32_t>(_island_start.size());
+            _island_start.push_back(0);
+        }
+        uint32_t island = _island_ids[root];
+        _contact_islands[i] = island;
+        ++_island_start[island];
+    }
+
+    // Counting sort of contacts by island (stable, keeps pair order)
+    uint32_t offset = 0;
+    for (uint32_t& start : _island_start) {
+        uint32_t count = start;
+        start = offset;
+        offset += count;
+    }
+    _island_start.push_back(offset);
+
+    _island_contacts.resize(_contacts.size());
+    for (size_t i = 0; i < _contacts.size(); ++i) {
+        _island_contacts[_island_start[_contact_islands[i]]++] = static_cast<uint32_t>(i);
+    }
+
+    // Undo the fill offsets
+    for (size_t island = _island_start.size() - 1; island > 0; --island) {
+        _island_start[island] = _island_start[island - 1];
+    }
+    _island_start[0] = 0;
+}
+
+void PhysicsWorld::add_trigger_overlap(uint32_t a, uint32_t b) {
+    // Report from the trigger's side (the lower index when both are triggers)
+    if (!_store.is_trigger(a)) std::swap(a, b);
+
+    TriggerOverlap overlap;
+    overlap.key = ContactCache::make_key(_store.slots[a], _store.slots[b]);
+    overlap.trigger = _store.handle(a);
+    overlap.other = _store.handle(b);
+    _new_trigger_overlaps.push_back(overlap);
+}
+
+void PhysicsWorld::update_triggers() {
+    auto by_key = [](const TriggerOverlap& a, const TriggerOverlap& b) { return a.key < b.key; };
+    std::sort(_new_trigger_overlaps.begin(), _new_trigger_overlaps.end(), by_key);
+
+    // A pair of resting bodies (static or sleeping) is never generated by the
+    // broad phase, but neither body has moved, so the overlap is still on
+    auto resting = [this](BodyHandle handle) {
+        uint32_t index = _store.dense_index(handle);
+        return _store.is_static(index) || _store.is_sleeping(index);
+    };
+
+    // Merge the sorted old and new overlap sets
+    size_t old_count = _trigger_overlaps.size();
+    size_t new_count = _new_trigger_overlaps.size();
+    size_t i = 0;
+    size_t j = 0;
+    while (i < old_count || j < new_count) {
+        if (j == new_count || (i < old_count && _trigger_overlaps[i].key < _new_trigger_overlaps[j].key)) {
+            const TriggerOverlap& old = _trigger_overlaps[i++];
+            if (resting(old.trigger) && resting(old.other)) {
+                _new_trigger_overlaps.push_back(old);
+            } else {
+                _trigger_events.push_back(TriggerEvent{TriggerEventType::Exit, old.trigger, old.other});
+            }
+        } else if (i == old_count || _new_trigger_overlaps[j].key < _trigger_overlaps[i].key) {
+            const TriggerOverlap& overlap = _new_trigger_overlaps[j++];
+            _trigger_events.push_back(TriggerEvent{TriggerEventType::Enter, overlap.trigger, overlap.other});
+        } else {
+            ++i;
+            ++j;
+        }
+    }
+
+    // Carried-over resting overlaps were appended past the sorted range
+    if (_new_trigger_overlaps.size() > new_count) {
+        std::sort(_new_trigger_overlaps.begin(), _new_trigger_overlaps.end(), by_key);
+    }
+    _trigger_overlaps.swap(_new_trigger_overlaps);
+}
+
+void PhysicsWorld::wake_touched(uint32_t a, uint32_t b) {
+    // The broad phase never pairs two resting bodies, so at most one side
+    // sleeps; a static body wakes it only when it was moved by hand
+    auto moves = [this](uint32_t index) {
+        return !_store.is_static(index) || _proxies[index].is_moved;
+    };
+    if (_store.is_sleeping(a) && moves(b)) {
+        wake_body(a);
+    } else if (_store.is_sleeping(b) && moves(a)) {
+        wake_body(b);
+    }
+}
+
+void PhysicsWorld::update_sleep(float delta) {
+    if (!_sleeping_enabled) return;
+
+    const uint32_t body_count = _store.size();
+    const float sleep_velocity_sq = SLEEP_LINEAR_VELOCITY * SLEEP_LINEAR_VELOCITY;
+
+    // Rest timers of awake dynamic bodies
+    for (uint32_t i = 0; i < body_count; ++i) {
+        if (_store.inv_mass[i] <= 0.0f || _store.is_sleeping(i)) continue;
+
+        glm::vec3 velocity = _store.velocity(i);
+        bool resting = glm::dot(velocity, velocity) < sleep_velocity_sq &&
+                       (_store.flags[i] & BODY_NEVER_SLEEP) == 0;
+        _store.sleep_time[i] = resting ? _store.sleep_time[i] + delta : 0.0f;
+    }
+
+    // Islands over this step's contacts (bodies touched by an awake body were
+    // woken during detection, so every contact is between awake bodies)
+    union_contact_islands();
+
+    // An island sleeps once its most recently active body has rested long enough
+    _island_sleep_time.assign(body_count, std::numeric_limits<float>::max());
+    for (uint32_t i = 0; i < body_count; ++i) {
+        if (_store.inv_mass[i] <= 0.0f || _store.is_sleeping(i)) continue;
+
+        float& island_time = _island_sleep_time[find_island_root(i)];
+        island_time = std::min(island_time, _store.sleep_time[i]);
+    }
+
+    for (uint32_t i = 0; i < body_count; ++i) {
+        if (_store.inv_mass[i] <= 0.0f || _store.is_sleeping(i)) continue;
+        if (_island_sleep_time[find_island_root(i)] < TIME_TO_SLEEP) continue;
+
+        _store.set_velocity(i, glm::vec3(0.0f));
+        _store.set_flags(i, _store.flags[i] | BODY_SLEEPING);
+        ++_sleeping_count;
+    }
+}
+
+void PhysicsWorld::solve_island(size_t island) {
+    const uint32_t begin = _island_start[island];
+    const uint32_t end = _island_start[island + 1];
 
-    float correction_magnitude = std::max(result.penetration - slop, 0.0f) * correction_percent;
-    glm::vec3 correction = result.normal * correction_magnitude / total_inv_mass;
+    // Set up each contact and apply last step's impulse
+    for (uint32_t i = begin; i < end; ++i) {
+        prepare_contact(_contacts[_island_contacts[i]]);
+    }
 
-    if (!a->is_static) {
-        a->position -= correction * inv_mass_a;
+    // Sequential impulses: each pass corrects the relative normal velocity of
+    // every contact in turn, so corrections propagate through stacks and crowds
+    for (int iteration = 0; iteration < _solver_iterations; ++iteration) {
+        for (uint32_t i = begin; i < end; ++i) {
+            solve_contact_velocity(_contacts[_island_contacts[i]]);
+        }
     }
-    if (!b->is_static) {
-        b->position += correction * inv_mass_b;
+
+    for (uint32_t i = begin; i < end; ++i) {
+        correct_contact_position(_contacts[_island_contacts[i]]);
     }
+}
 
-    // Velocity resolution (impulse-based)
-    glm::vec3 relative_velocity = b->velocity - a->velocity;
-    float velocity_along_normal = glm::dot(relative_velocity, result.normal);
+void PhysicsWorld::prepare_contact(Contact& contact) {
+    uint32_t a = contact.a;
+    uint32_t b = contact.b;
+
+    // Calculate inverse masses (0 for static bodies)
+    float total_inv_mass = _store.inv_mass[a] + _store.inv_mass[b];
+    contact.normal_impulse = 0.0f;
+    if (total_inv_mass <= 0.0f) {
+        contact.normal_mass = 0.0f;  // Both static
+        return;
+    }
+    contact.normal_mass = 1.0f / total_inv_mass;
 
-    // Don't resolve if velocities are separating
-    if (velocity_along_normal > 0) return;
+    // Bounce off the approach speed from before this step's impulses
+    // (restitution uses the minimum of the two bodies)
+    glm::vec3 relative_velocity = _store.velocity(b) - _store.velocity(a);
+    float velocity_along_normal = glm::dot(relative_velocity, contact.result.normal);
+    float restitution = std::min(_store.restitution[a], _store.restitution[b]);
+    contact.target_velocity = velocity_along_normal < 0.0f ? -restitution * velocity_along_normal : 0.0f;
 
-    // Calculate restitution (use minimum)
-    float restitution = std::min(a->restitution, b->restitution);
+    if (!_warm_starting) return;
+
+    uint32_t slot_a = _store.slots[a];
+    uint32_t slot_b = _store.slots[b];
+    const CachedContact* cached = _contact_cache.find(ContactCache::make_key(slot_a, slot_b));
+    if (!cached) return;
+
+    glm::vec3 cached_normal = slot_a < slot_b ? cached->normal : -cached->normal;
+    if (glm::dot(cached_normal, contact.result.normal) < WARM_START_MIN_COS) return;
+
+    contact.normal_impulse = cached->normal_impulse;
+    apply_contact_impulse(contact, contact.normal_impulse);
+}
+
+void PhysicsWorld::apply_contact_impulse(const Contact& contact, float impulse_magnitude) {
+    glm::vec3 impulse = impulse_magnitude * contact.result.normal;
+
+    // Static bodies are never written (islands solved in parallel share them)
+    float inv_mass_a = _store.inv_mass[contact.a];
+    float inv_mass_b = _store.inv_mass[contact.b];
+    if (inv_mass_a > 0.0f) _store.set_velocity(contact.a, _store.velocity(contact.a) - impulse * inv_mass_a);
+    if (inv_mass_b > 0.0f) _store.set_velocity(contact.b, _store.velocity(contact.b) + impulse * inv_mass_b);
+}
 
-    // Calculate impulse scalar
-    float j = -(1.0f + restitution) * velocity_along_normal;
-    j /= total_inv_mass;
+void PhysicsWorld::solve_contact_velocity(Contact& contact) {
+    if (contact.normal_mass <= 0.0f) return;
 
-    // Apply impulse
-    glm::vec3 impulse = j * result.normal;
+    glm::vec3 relative_velocity = _store.velocity(contact.b) - _store.velocity(contact.a);
+    float velocity_along_normal = glm::dot(relative_velocity, contact.result.normal);
 
-    if (!a->is_static) {
-        a->velocity -= impulse * inv_mass_a;
+    // Clamp the accumulated impulse rather than each increment, so a later
+    // iteration can take back part of an earlier push (contacts only push)
+    float delta = (contact.target_velocity - velocity_along_normal) * contact.normal_mass;
+    float accumulated = std::max(contact.normal_impulse + delta, 0.0f);
+    delta = accumulated - contact.normal_impulse;
+    contact.normal_impulse = accumulated;
+
+    if (delta != 0.0f) {
+        apply_contact_impulse(contact, delta);
     }
-    if (!b->is_static) {
-        b->velocity += impulse * inv_mass_b;
+}
+
+void PhysicsWorld::correct_contact_position(const Contact& contact) {
+    float inv_mass_a = _store.inv_mass[contact.a];
+    float inv_mass_b = _store.inv_mass[contact.b];
+    float total_inv_mass = inv_mass_a + inv_mass_b;
+
+    if (total_inv_mass <= 0.0f) return;  // Both static
+
+    // Position correction (separate the bodies)
+    const float correction_percent = 0.8f;  // Penetration percentage to correct
+    const float slop = 0.01f;  // Small allowance to prevent jitter
+
+    float correction_magnitude = std::max(contact.result.penetration - slop, 0.0f) * correction_percent;
+    glm::vec3 correction = contact.result.normal * correction_magnitude / total_inv_mass;
+
+    if (inv_mass_a > 0.0f) _store.set_position(contact.a, _store.position(contact.a) - correction * inv_mass_a);
+    if (inv_mass_b > 0.0f) _store.set_position(contact.b, _store.position(contact.b) + correction * inv_mass_b);
+}
+
+void PhysicsWorld::store_contacts() {
+    // Keep the accumulated impulses for the next step's warm start
+    _contact_cache.begin_step();
+    for (const Contact& contact : _contacts) {
+        if (contact.normal_mass <= 0.0f) continue;
+
+        uint32_t slot_a = _store.slots[contact.a];
+        uint32_t slot_b = _store.slots[contact.b];
+
+        CachedContact cached;
+        cached.key = ContactCache::make_key(slot_a, slot_b);
+        cached.normal = slot_a < slot_b ? contact.result.normal : -contact.result.normal;
+        cached.point = contact.result.contact_point;
+        cached.normal_impulse = contact.normal_impulse;
+        _contact_cache.store(cached);
     }
+    _contact_cache.end_step();
 }
 
 }  // namespace engine::physics
@@ -1,62 +1,270 @@
 #include <engine/physics/rigid_body.hpp>
+#include <engine/physics/physics_world.hpp>
 
 namespace engine::physics {
 
-void RigidBody::apply_force(glm::vec3 force) {
-    if (is_static) return;
-    _accumulated_force += force;
+RigidBody::~RigidBody() {
+    if (_world) {
+        _world->remove_body(this);
+    }
 }
 
-void RigidBody::apply_impulse(glm::vec3 impulse) {
-    if (is_static) return;
-    velocity += impulse * inv_mass;
-}
+RigidBody::RigidBody(RigidBody&& other) noexcept
+    : user_data(other.user_data)
+    , _world(other._world)
+    , _handle(other._handle)
+    , _local(other._local)
+{
+    other._world = nullptr;
+    other._handle = BodyHandle{};
 
-void RigidBody::clear_forces() {
-    _accumulated_force = glm::vec3(0.0f);
+    if (_world) {
+        _world->rebind_body(this);
+    }
 }
 
-void RigidBody::integrate(float delta, glm::vec3 gravity) {
-    if (is_static) return;
+RigidBody& RigidBody::operator=(RigidBody&& other) noexcept {
+    if (this == &other) return *this;
 
-    // Apply gravity
-    if (use_gravity) {
-        velocity += gravity * delta;
+    if (_world) {
+        _world->remove_body(this);
     }
 
-    // Apply accumulated forces (F = ma -> a = F/m -> a = F * inv_mass)
-    velocity += _accumulated_force * inv_mass * delta;
+    user_data = other.user_data;
+    _world = other._world;
+    _handle = other._handle;
+    _local = other._local;
+
+    other._world = nullptr;
+    other._handle = BodyHandle{};
+
+    if (_world) {
+        _world->rebind_body(this);
+    }
+    return *this;
+}
+
+BodyStore& RigidBody::store() const {
+    return _world->_store;
+}
 
-    // Apply drag
-    velocity *= (1.0f - drag * delta);
+uint32_t RigidBody::index() const {
+    return _world->_store.dense_index(_handle);
+}
 
-    // Update position
-    position += velocity * delta;
+void RigidBody::apply_force(glm::vec3 force) {
+    if (is_static()) return;
+    wake();
+    if (_world) {
+        store().set_force(index(), store().force(index()) + force);
+    } else {
+        _local.force += force;
+    }
+}
 
-    // Clear forces for next frame
-    clear_forces();
+void RigidBody::apply_impulse(glm::vec3 impulse) {
+    if (is_static()) return;
+    wake();
+    set_velocity(velocity() + impulse * inv_mass());
+}
+
+void RigidBody::clear_forces() {
+    if (_world) {
+        store().set_force(index(), glm::vec3(0.0f));
+    } else {
+        _local.force = glm::vec3(0.0f);
+    }
 }
 
 glm::vec3 RigidBody::world_position() const {
-    if (shape) {
-        return position + shape->offset;
+    if (const CollisionShape* body_shape = shape()) {
+        return position() + body_shape->offset();
     }
-    return position;
+    return position();
 }
 
 void RigidBody::set_sphere(float radius) {
-    shape = std::make_unique<SphereShape>(radius);
-    inv_mass = is_static ? 0.0f : 1.0f / mass;
+    set_shape(SphereShape(radius));
 }
 
 void RigidBody::set_aabb(glm::vec3 half_extents) {
-    shape = std::make_unique<AABBShape>(half_extents);
-    inv_mass = is_static ? 0.0f : 1.0f / mass;
+    set_shape(AABBShape(half_extents));
 }
 
 void RigidBody::set_capsule(float radius, float height) {
-    shape = std::make_unique<CapsuleShape>(radius, height);
-    inv_mass = is_static ? 0.0f : 1.0f / mass;
+    set_shape(CapsuleShape(radius, height));
+}
+
+void RigidBody::set_mesh(const TriangleMesh* mesh) {
+    set_shape(MeshShape(mesh));
+    set_static(true);
+}
+
+void RigidBody::set_height_field(const HeightField* field) {
+    set_shape(HeightFieldShape(field));
+    set_static(true);
+}
+
+void RigidBody::set_shape(const CollisionShape& shape) {
+    wake();
+    if (_world) {
+        store().shapes[index()] = shape;
+        _world->on_shape_changed(this);
+    } else {
+        _local.shape = shape;
+    }
+}
+
+const CollisionShape* RigidBody::shape() const {
+    const CollisionShape& body_shape = _world ? store().shapes[index()] : _local.shape;
+    return body_shape.empty() ? nullptr : &body_shape;
+}
+
+glm::vec3 RigidBody::position() const {
+    return _world ? store().position(index()) : _local.position;
+}
+
+void RigidBody::set_position(glm::vec3 position) {
+    wake();
+    if (_world) {
+        store().set_position(index(), position);
+        _world->on_position_changed(this);
+    } else {
+        _local.position = position;
+    }
+}
+
+glm::vec3 RigidBody::interpolated_position() const {
+    return _world ? _world->interpolated_position(index()) : _local.position;
+}
+
+glm::vec3 RigidBody::velocity() const {
+    return _world ? store().velocity(index()) : _local.velocity;
+}
+
+void RigidBody::set_velocity(glm::vec3 velocity) {
+    // Setting a resting body's velocity to zero leaves it asleep
+    if (glm::dot(velocity, velocity) > 0.0f) wake();
+    if (_world) {
+        store().set_velocity(index(), velocity);
+    } else {
+        _local.velocity = velocity;
+    }
+}
+
+float RigidBody::mass() const {
+    return _world ? store().mass[index()] : _local.mass;
+}
+
+void RigidBody::set_mass(float mass) {
+    if (_world) {
+        store().mass[index()] = mass;
+    } else {
+        _local.mass = mass;
+    }
+    refresh_inv_mass();
+}
+
+float RigidBody::inv_mass() const {
+    return _world ? store().inv_mass[index()] : _local.inv_mass;
+}
+
+float RigidBody::drag() const {
+    return _world ? store().drag[index()] : _local.drag;
+}
+
+void RigidBody::set_drag(float drag) {
+    if (_world) {
+        store().drag[index()] = drag;
+    } else {
+        _local.drag = drag;
+    }
+}
+
+float RigidBody::restitution() const {
+    return _world ? store().restitution[index()] : _local.restitution;
+}
+
+void RigidBody::set_restitution(float restitution) {
+    if (_world) {
+        store().restitution[index()] = restitution;
+    } else {
+        _local.restitution = restitution;
+    }
+}
+
+void RigidBody::set_use_gravity(bool use_gravity) {
+    set_flag(BODY_USE_GRAVITY, use_gravity);
+}
+
+void RigidBody::set_static(bool is_static) {
+    wake();
+    set_flag(BODY_STATIC, is_static);
+    refresh_inv_mass();
+}
+
+void RigidBody::set_trigger(bool is_trigger) {
+    set_flag(BODY_TRIGGER, is_trigger);
+}
+
+uint32_t RigidBody::collision_layer() const {
+    return _world ? store().collision_layers[index()] : _local.collision_layer;
+}
+
+void RigidBody::set_collision_layer(uint32_t layer) {
+    if (_world) {
+        store().collision_layers[index()] = layer;
+    } else {
+        _local.collision_layer = layer;
+    }
+}
+
+uint32_t RigidBody::collision_mask() const {
+    return _world ? store().collision_masks[index()] : _local.collision_mask;
+}
+
+void RigidBody::set_collision_mask(uint32_t mask) {
+    if (_world) {
+        store().collision_masks[index()] = mask;
+    } else {
+        _local.collision_mask = mask;
+    }
+}
+
+void RigidBody::wake() {
+    if (!is_sleeping()) return;
+    if (_world) {
+        _world->wake_body(index());
+    } else {
+        _local.flags &= ~BODY_SLEEPING;
+    }
+}
+
+void RigidBody::set_can_sleep(bool can_sleep) {
+    if (!can_sleep) wake();
+    set_flag(BODY_NEVER_SLEEP, !can_sleep);
+}
+
+uint32_t RigidBody::flags() const {
+    return _world ? store().flags[index()] : _local.flags;
+}
+
+void RigidBody::set_flag(uint32_t flag, bool enabled) {
+    uint32_t new_flags = enabled ? (flags() | flag) : (flags() & ~flag);
+    if (_world) {
+        store().set_flags(index(), new_flags);
+    } else {
+        _local.flags = new_flags;
+    }
+}
+
+void RigidBody::refresh_inv_mass() {
+    float inv = (is_static() || mass() <= 0.0f) ? 0.0f : 1.0f / mass();
+    if (_world) {
+        store().inv_mass[index()] = inv;
+    } else {
+        _local.inv_mass = inv;
+    }
 }
 
 }  // namespace engine::physics
@@ -0,0 +1,152 @@
+#include <engine/physics/spatial_hash_broad_phase.hpp>
+
+#include <algorithm>
+#include <cmath>
+
+namespace engine::physics {
+
+SpatialHashBroadPhase::SpatialHashBroadPhase(float cell_size) {
+    set_cell_size(cell_size);
+}
+
+void SpatialHashBroadPhase::set_cell_size(float cell_size) {
+    _cell_size = std::max(cell_size, 0.01f);
+    _inv_cell_size = 1.0f / _cell_size;
+}
+
+namespace {
+
+// Cell coordinates are clamped to what a cell key holds (21 bits per axis),
+// so far-away bodies share the edge cells instead of overflowing the cast
+constexpr float MAX_CELL_COORD = static_cast<float>((1 << 20) - 1);
+
+int cell_coord(float scaled) {
+    return static_cast<int>(std::min(std::max(std::floor(scaled), -MAX_CELL_COORD), MAX_CELL_COORD));
+}
+
+}  // namespace
+
+glm::ivec3 SpatialHashBroadPhase::cell_of(glm::vec3 point) const {
+    return glm::ivec3(
+        cell_coord(point.x * _inv_cell_size),
+        cell_coord(point.y * _inv_cell_size),
+        cell_coord(point.z * _inv_cell_size));
+}
+
+uint64_t SpatialHashBroadPhase::cell_key(glm::ivec3 cell) {
+    // 21 bits per axis, enough for +-1M cells in every direction
+    const uint64_t mask = (1ull << 21) - 1;
+    return ((static_cast<uint64_t>(cell.x) & mask) << 42) |
+           ((static_cast<uint64_t>(cell.y) & mask) << 21) |
+           (static_cast<uint64_t>(cell.z) & mask);
+}
+
+void SpatialHashBroadPhase::find_pairs(const std::vector<BroadPhaseProxy>& proxies,
+                                       std::vector<BodyPair>& out_pairs) {
+    _entries.clear();
+    _oversized.clear();
+
+    // Step 1: Insert every enabled body into the cells its bounds overlap
+    uint32_t count = static_cast<uint32_t>(proxies.size());
+    for (uint32_t i = 0; i < count; ++i) {
+        const BroadPhaseProxy& proxy = proxies[i];
+        if (!proxy.enabled) continue;
+
+        if (!has_finite_bounds(proxy)) continue;
+
+        glm::ivec3 lo = cell_of(proxy.bounds.min);
+        glm::ivec3 hi = cell_of(proxy.bounds.max);
+
+        int64_t cells = static_cast<int64_t>(hi.x - lo.x + 1) *
+                        static_cast<int64_t>(hi.y - lo.y + 1) *
+                        static_cast<int64_t>(hi.z - lo.z + 1);
+        if (cells > MAX_CELLS_PER_BODY) {
+            _oversized.push_back(i);
+            continue;
+        }
+
+        for (int x = lo.x; x <= hi.x; ++x) {
+            for (int y = lo.y; y <= hi.y; ++y) {
+                for (int z = lo.z; z <= hi.z; ++z) {
+                    _entries.push_back({cell_key(glm::ivec3(x, y, z)), i});
+                }
+            }
+        }
+    }
+
+    // Step 2: Counting sort entries into hash buckets (stable, so bodies stay
+    // in ascending index order within a bucket)
+    size_t bucket_count = 64;
+    while (bucket_count < _entries.size() * 2) {
+        bucket_count <<= 1;
+    }
+    const uint64_t bucket_mask = bucket_count - 1;
+    auto bucket_of = [bucket_mask](uint64_t key) {
+        return static_cast<size_t>((key * 0x9E3779B97F4A7C15ull) >> 32) & bucket_mask;
+    };
+
+    _bucket_start.assign(bucket_count + 1, 0);
+    for (const CellEntry& entry : _entries) {
+        ++_bucket_start[bucket_of(entry.key) + 1];
+    }
+    for (size_t b = 0; b < bucket_count; ++b) {
+        _bucket_start[b + 1] += _bucket_start[b];
+    }
+
+    _sorted.resize(_entries.size());
+    for (const CellEntry& entry : _entries) {
+        _sorted[_bucket_start[bucket_of(entry.key)]++] = entry;
+    }
+    // Scatter advanced each start to the next bucket's start; shift back
+    for (size_t b = bucket_count; b > 0; --b) {
+        _bucket_start[b] = _bucket_start[b - 1];
+    }
+    _bucket_start[0] = 0;
+
+    // Step 3: Test pairs that share a cell
+    for (size_t b = 0; b < bucket_count; ++b) {
+        uint32_t begin = _bucket_start[b];
+        uint32_t end = _bucket_start[b + 1];
+
+        for (uint32_t i = begin; i < end; ++i) {
+            const CellEntry& ea = _sorted[i];
+            for (uint32_t j = i + 1; j < end; ++j) {
+                const CellEntry& eb = _sorted[j];
+                if (ea.key != eb.key) continue;  // Hash collision between different cells
+
+                const BroadPhaseProxy& pa = proxies[ea.body];
+                const BroadPhaseProxy& pb = proxies[eb.body];
+                if (!should_test_pair(pa, pb)) continue;
+                if (!pa.bounds.overlaps(pb.bounds)) continue;
+
+                // Bodies sharing several cells would be reported once per cell;
+                // only report from the cell holding the min corner of the overlap
+                glm::vec3 overlap_min = glm::max(pa.bounds.min, pb.bounds.min);
+                if (cell_key(cell_of(overlap_min)) != ea.key) continue;
+
+                out_pairs.push_back({std::min(ea.body, eb.body), std::max(ea.body, eb.body)});
+            }
+        }
+    }
+
+    // Step 4: Oversized bodies against everything else
+    for (size_t k = 0; k < _oversized.size(); ++k) {
+        uint32_t big = _oversized[k];
+        const BroadPhaseProxy& pbig = proxies[big];
+
+        for (uint32_t i = 0; i < count; ++i) {
+            if (i == big) continue;
+            // Oversized-vs-oversized pairs are reported by the lower index only
+            bool other_oversized = std::binary_search(_oversized.begin(), _oversized.end(), i);
+            if (other_oversized && i < big) continue;
+
+            const BroadPhaseProxy& other = proxies[i];
+            if (!should_test_pair(pbig, other)) continue;
+            if (!pbig.bounds.overlaps(other.bounds)) continue;
+
+            out_pairs.push_back({std::min(big, i), std::max(big, i)});
+        }
+    }
+}
+
+}  // namespace engine::physics
@@ -0,0 +1,77 @@
+#include <engine/physics/static_bvh.hpp>
+
+#include <algorithm>
+
+namespace engine::physics {
+
+void StaticBVH::build(const std::vector<AABB>& primitive_bounds) {
+    clear();
+    if (primitive_bounds.empty()) return;
+
+    uint32_t count = static_cast<uint32_t>(primitive_bounds.size());
+
+    std::vector<glm::vec3> centroids(count);
+    _primitives.resize(count);
+    for (uint32_t i = 0; i < count; ++i) {
+        centroids[i] = primitive_bounds[i].center();
+        _primitives[i] = i;
+    }
+
+    // A binary tree with at least one primitive per leaf has < 2n nodes
+    _nodes.reserve(2 * (count / MAX_LEAF_PRIMITIVES + 1));
+    build_node(primitive_bounds, centroids, 0, count);
+
+    _leaf_bounds.resize(count);
+    for (uint32_t i = 0; i < count; ++i) {
+        _leaf_bounds[i] = primitive_bounds[_primitives[i]];
+    }
+}
+
+void StaticBVH::clear() {
+    _nodes.clear();
+    _primitives.clear();
+    _leaf_bounds.clear();
+}
+
+uint32_t StaticBVH::build_node(const std::vector<AABB>& primitive_bounds,
+                               const std::vector<glm::vec3>& centroids,
+                               uint32_t begin, uint32_t end) {
+    uint32_t id = static_cast<uint32_t>(_nodes.size());
+    _nodes.emplace_back();
+
+    AABB bounds = primitive_bounds[_primitives[begin]];
+    AABB centroid_bounds(centroids[_primitives[begin]], centroids[_primitives[begin]]);
+    for (uint32_t i = begin + 1; i < end; ++i) {
+        bounds = bounds.merged(primitive_bounds[_primitives[i]]);
+        glm::vec3 c = centroids[_primitives[i]];
+        centroid_bounds = centroid_bounds.merged(AABB(c, c));
+    }
+    _nodes[id].bounds = bounds;
+
+    if (end - begin <= MAX_LEAF_PRIMITIVES) {
+        _nodes[id].first = begin;
+        _nodes[id].count = end - begin;
+        return id;
+    }
+
+    // Split the longest centroid axis at the median
+    glm::vec3 extents = centroid_bounds.extents();
+    int axis = 0;
+    if (extents.y > extents[axis]) axis = 1;
+    if (extents.z > extents[axis]) axis = 2;
+
+    uint32_t mid = begin + (end - begin) / 2;
+    std::nth_element(_primitives.begin() + begin, _primitives.begin() + mid, _primitives.begin() + end,
+                     [&](uint32_t a, uint32_t b) {
+        if (centroids[a][axis] != centroids[b][axis]) return centroids[a][axis] < centroids[b][axis];
+        return a < b;  // Ties by index, so the tree doesn't depend on the sort
+    });
+
+    build_node(primitive_bounds, centroids, begin, mid);  // First child is id + 1
+    uint32_t second = build_node(primitive_bounds, centroids, mid, end);
+    _nodes[id].first = second;
+    _nodes[id].count = 0;
+    return id;
+}
+
+}  // namespace engine::physics
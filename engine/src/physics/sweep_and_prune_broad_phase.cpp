@@ -0,0 +1,153 @@
+#include <engine/physics/sweep_and_prune_broad_phase.hpp>
+
+#include <algorithm>
+#include <cmath>
+
+namespace engine::physics {
+
+float SweepAndPruneBroadPhase::endpoint_value(const BroadPhaseProxy& proxy, int axis, bool is_max) {
+    if (!has_finite_bounds(proxy)) return INFINITY;
+    return is_max ? proxy.bounds.max[axis] : proxy.bounds.min[axis];
+}
+
+void SweepAndPruneBroadPhase::add_proxy(uint32_t index) {
+    if (_dirty) return;
+    if (index != _proxy_count) {
+        _dirty = true;
+        return;
+    }
+
+    // Placeholders at the end; the next refresh sorts them into place
+    for (std::vector<Endpoint>& endpoints : _axes) {
+        endpoints.push_back({INFINITY, index << 1});
+        endpoints.push_back({INFINITY, (index << 1) | 1u});
+    }
+    _active_slot.push_back(0);
+    ++_proxy_count;
+}
+
+void SweepAndPruneBroadPhase::remove_proxy(uint32_t index, uint32_t last) {
+    if (_dirty) return;
+    if (index >= _proxy_count || last + 1 != _proxy_count) {
+        _dirty = true;
+        return;
+    }
+
+    // Drop the body's endpoints (keeping the order) and rename the body that
+    // moved into its index
+    for (std::vector<Endpoint>& endpoints : _axes) {
+        endpoints.erase(std::remove_if(endpoints.begin(), endpoints.end(),
+                                       [&](const Endpoint& e) { return e.body() == index; }),
+                        endpoints.end());
+        if (last == index) continue;
+        for (Endpoint& endpoint : endpoints) {
+            if (endpoint.body() == last) {
+                endpoint.data = (index << 1) | (endpoint.data & 1u);
+            }
+        }
+    }
+    _active_slot.pop_back();
+    --_proxy_count;
+}
+
+void SweepAndPruneBroadPhase::rebuild(const std::vector<BroadPhaseProxy>& proxies) {
+    uint32_t count = static_cast<uint32_t>(proxies.size());
+
+    for (int axis = 0; axis < 3; ++axis) {
+        std::vector<Endpoint>& endpoints = _axes[axis];
+        endpoints.resize(static_cast<size_t>(count) * 2);
+        for (uint32_t i = 0; i < count; ++i) {
+            endpoints[i * 2] = {endpoint_value(proxies[i], axis, false), i << 1};
+            endpoints[i * 2 + 1] = {endpoint_value(proxies[i], axis, true), (i << 1) | 1u};
+        }
+        std::sort(endpoints.begin(), endpoints.end());
+    }
+
+    _active_slot.assign(count, 0);
+    _proxy_count = count;
+    _dirty = false;
+}
+
+void SweepAndPruneBroadPhase::refresh_axis(int axis, const std::vector<BroadPhaseProxy>& proxies) {
+    std::vector<Endpoint>& endpoints = _axes[axis];
+
+    for (Endpoint& endpoint : endpoints) {
+        endpoint.value = endpoint_value(proxies[endpoint.body()], axis, endpoint.is_max());
+    }
+
+    // Insertion sort: nearly sorted input from last step makes this ~O(n)
+    for (size_t i = 1; i < endpoints.size(); ++i) {
+        Endpoint key = endpoints[i];
+        size_t j = i;
+        while (j > 0 && key < endpoints[j - 1]) {
+            endpoints[j] = endpoints[j - 1];
+            --j;
+        }
+        endpoints[j] = key;
+    }
+}
+
+int SweepAndPruneBroadPhase::choose_sweep_axis(const std::vector<BroadPhaseProxy>& proxies) const {
+    // Sweep along the axis where body centers are most spread out
+    glm::vec3 sum(0.0f);
+    glm::vec3 sum_sq(0.0f);
+    float count = 0.0f;
+
+    for (const BroadPhaseProxy& proxy : proxies) {
+        if (!proxy.enabled || !has_finite_bounds(proxy)) continue;
+        glm::vec3 c = proxy.bounds.center();
+        sum += c;
+        sum_sq += c * c;
+        count += 1.0f;
+    }
+
+    if (count < 2.0f) return _sweep_axis;
+
+    glm::vec3 variance = sum_sq / count - (sum / count) * (sum / count);
+    if (variance.x >= variance.y && variance.x >= variance.z) return 0;
+    if (variance.y >= variance.z) return 1;
+    return 2;
+}
+
+void SweepAndPruneBroadPhase::find_pairs(const std::vector<BroadPhaseProxy>& proxies,
+                                         std::vector<BodyPair>& out_pairs) {
+    if (_dirty || proxies.size() != _proxy_count) {
+        rebuild(proxies);
+    } else {
+        for (int axis = 0; axis < 3; ++axis) {
+            refresh_axis(axis, proxies);
+        }
+    }
+
+    _sweep_axis = choose_sweep_axis(proxies);
+
+    // Sweep: a body overlaps every body that is still open when it opens
+    _active.clear();
+    for (const Endpoint& endpoint : _axes[_sweep_axis]) {
+        uint32_t body = endpoint.body();
+        const BroadPhaseProxy& proxy = proxies[body];
+        if (!proxy.enabled || !has_finite_bounds(proxy)) continue;
+
+        if (endpoint.is_max()) {
+            // Swap-remove from the active list
+            uint32_t slot = _active_slot[body];
+            uint32_t last = _active.back();
+            _active[slot] = last;
+            _active_slot[last] = slot;
+            _active.pop_back();
+            continue;
+        }
+
+        for (uint32_t other : _active) {
+            const BroadPhaseProxy& other_proxy = proxies[other];
+            if (!should_test_pair(proxy, other_proxy)) continue;
+            if (!proxy.bounds.overlaps(other_proxy.bounds)) continue;
+            out_pairs.push_back({std::min(body, other), std::max(body, other)});
+        }
+
+        _active_slot[body] = static_cast<uint32_t>(_active.size());
+        _active.push_back(body);
+    }
+}
+
+}  // namespace engine::physics
@@ -0,0 +1,85 @@
+#include <engine/physics/task_pool.hpp>
+
+#include <algorithm>
+
+namespace engine::physics {
+
+TaskPool::TaskPool(unsigned thread_count) {
+    unsigned workers = thread_count > 1 ? thread_count - 1 : 0;
+    _workers.reserve(workers);
+    for (unsigned i = 0; i < workers; ++i) {
+        _workers.emplace_back([this]() { worker_loop(); });
+    }
+}
+
+TaskPool::~TaskPool() {
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _stop = true;
+    }
+    _wake.notify_all();
+    for (std::thread& worker : _workers) {
+        worker.join();
+    }
+}
+
+void TaskPool::parallel_for(size_t count, size_t min_chunk, const RangeFunc& func) {
+    if (count == 0) return;
+
+    // Not worth waking anyone up
+    if (_workers.empty() || count <= min_chunk) {
+        func(0, count);
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _func = &func;
+        _count = count;
+        // A few chunks per thread so uneven work still balances
+        size_t target_chunks = static_cast<size_t>(thread_count()) * 4;
+        _chunk = std::max(min_chunk, (count + target_chunks - 1) / target_chunks);
+        _next.store(0, std::memory_order_relaxed);
+        _busy_workers = static_cast<unsigned>(_workers.size());
+        ++_generation;
+    }
+    _wake.notify_all();
+
+    run_chunks();
+
+    std::unique_lock<std::mutex> lock(_mutex);
+    _done.wait(lock, [this]() { return _busy_workers == 0; });
+    _func = nullptr;
+}
+
+void TaskPool::run_chunks() {
+    for (;;) {
+        size_t begin = _next.fetch_add(_chunk, std::memory_order_relaxed);
+        if (begin >= _count) break;
+        (*_func)(begin, std::min(begin + _chunk, _count));
+    }
+}
+
+void TaskPool::worker_loop() {
+    uint64_t seen_generation = 0;
+
+    for (;;) {
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            _wake.wait(lock, [&]() { return _stop || _generation != seen_generation; });
+            if (_stop) return;
+            seen_generation = _generation;
+        }
+
+        run_chunks();
+
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            if (--_busy_workers == 0) {
+                _done.notify_one();
+            }
+        }
+    }
+}
+
+}  // namespace engine::physics
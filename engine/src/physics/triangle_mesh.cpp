@@ -0,0 +1,41 @@
+#include <engine/physics/triangle_mesh.hpp>
+
+#include <cassert>
+#include <utility>
+
+namespace engine::physics {
+
+glm::vec3 Triangle::normal() const {
+    glm::vec3 n = glm::cross(b - a, c - a);
+    float length = glm::length(n);
+    return length > 1e-12f ? n / length : glm::vec3(0.0f);
+}
+
+TriangleMesh::TriangleMesh(std::vector<glm::vec3> vertices, std::vector<uint32_t> indices)
+    : _vertices(std::move(vertices)), _indices(std::move(indices)) {
+    assert(_indices.size() % 3 == 0);
+    _indices.resize(_indices.size() / 3 * 3);
+
+    // Drop triangles that index past the vertices (a malformed mesh file),
+    // keeping the order of the rest
+    size_t kept = 0;
+    for (size_t i = 0; i < _indices.size(); i += 3) {
+        bool in_range = _indices[i] < _vertices.size() && _indices[i + 1] < _vertices.size() &&
+                        _indices[i + 2] < _vertices.size();
+        assert(in_range);
+        if (!in_range) continue;
+
+        _indices[kept++] = _indices[i];
+        _indices[kept++] = _indices[i + 1];
+        _indices[kept++] = _indices[i + 2];
+    }
+    _indices.resize(kept);
+
+    std::vector<AABB> triangle_bounds(triangle_count());
+    for (uint32_t i = 0; i < triangle_bounds.size(); ++i) {
+        triangle_bounds[i] = triangle(i).bounds();
+    }
+    _bvh.build(triangle_bounds);
+}
+
+}  // namespace engine::physics
@@ -181,6 +181,7 @@ std::shared_ptr<pbr::Skeleton> extract_skeleton(const aiScene* scene) {
         skeleton->root_node = std::make_shared<pbr::SkeletonNode>(
             build_node_hierarchy(scene->mRootNode)
         );
+        skeleton->build_hierarchy();
     }
 
     return skeleton;
@@ -245,6 +246,9 @@ std::vector<std::shared_ptr<pbr::AnimationClip>> extract_animations(const aiScen
             clip->add_channel(std::move(channel));
         }
 
+        // Drop keys interpolation rebuilds and quantize the rest
+        clip->compress();
+
         animations.push_back(clip);
     }
 
@@ -397,4 +401,32 @@ ModelLoader::ResourcePtr ModelLoader::operator()(const std::string& filepath) co
     return model;
 }
 
+std::vector<pbr::MeshData> ModelLoader::load_mesh_data(const std::string& filepath) {
+    Assimp::Importer importer;
+
+    const aiScene* scene = importer.ReadFile(filepath,
+        aiProcess_Triangulate |
+        aiProcess_JoinIdenticalVertices
+    );
+
+    std::vector<pbr::MeshData> meshes;
+    if (!scene || scene->mFlags & AI_SCENE_FLAGS_INCOMPLETE || !scene->mRootNode) {
+        std::cerr << "Failed to load model: " << filepath << " - " << importer.GetErrorString() << std::endl;
+        return meshes;
+    }
+
+    // Same traversal as operator(), so the data lines up with the rendered meshes
+    std::function<void(aiNode*)> process_meshes_only = [&](aiNode* node) {
+        for (unsigned int i = 0; i < node->mNumMeshes; ++i) {
+            meshes.push_back(process_mesh(scene->mMeshes[node->mMeshes[i]]));
+        }
+        for (unsigned int i = 0; i < node->mNumChildren; ++i) {
+            process_meshes_only(node->mChildren[i]);
+        }
+    };
+    process_meshes_only(scene->mRootNode);
+
+    return meshes;
+}
+
 }  // namespace engine::resource
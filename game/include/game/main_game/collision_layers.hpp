@@ -0,0 +1,16 @@
+#pragma once
+
+#include <cstdint>
+
+namespace main_game {
+
+// Collision layer bits of gameplay bodies in GameState::physics_world
+namespace collision_layer {
+
+constexpr uint32_t WORLD = 1u << 0;   // Engine default layer (level geometry)
+constexpr uint32_t PLAYER = 1u << 1;
+constexpr uint32_t ENEMY = 1u << 2;
+
+}  // namespace collision_layer
+
+}  // namespace main_game
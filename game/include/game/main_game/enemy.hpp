@@ -2,6 +2,12 @@
 
 #include <glm/glm.hpp>
 
+#include <engine/physics/character_controller.hpp>
+
+namespace engine::physics {
+class PhysicsWorld;
+}
+
 namespace main_game {
 class GameState;
 
@@ -25,7 +31,8 @@ public:
     void take_damage(float amount, GameState& game_state, glm::vec3 impact_pos);
 
     // Accessors
-    glm::vec3 position() const { return _position; }
+    glm::vec3 position() const { return _controller.position(); }
+    glm::vec3 interpolated_position(float alpha) const { return glm::mix(_previous_position, position(), alpha); }
     float rotation_y() const { return _rotation_y; }
     float health() const { return _health; }
     float max_health() const { return _max_health; }
@@ -37,6 +44,13 @@ public:
     // Collision radius for hit detection
     float collision_radius() const { return _collision_radius; }
 
+    // Movement: update() only sets the controller's desired velocity, the
+    // EnemyManager then moves every enemy in one batched call. Its capsule is
+    // also the hit volume (user_data points back at this enemy).
+    engine::physics::CharacterController& controller() { return _controller; }
+    const engine::physics::RigidBody& body() const { return _controller.body(); }
+    void sync_body(engine::physics::PhysicsWorld& world);
+
 private:
     // AI state handlers
     void update_idle(GameState& game_state, float delta);
@@ -48,7 +62,7 @@ private:
     float distance_to_player(const GameState& game_state) const;
     glm::vec3 direction_to_player(const GameState& game_state) const;
     void face_player(const GameState& game_state);
-    void move_toward_player(const GameState& game_state, float delta);
+    void move_toward_player(const GameState& game_state);
     void attack_melee(GameState& game_state);
     void attack_ranged(GameState& game_state);
 
@@ -57,7 +71,7 @@ private:
     EnemyState _state = EnemyState::Idle;
 
     // Transform
-    glm::vec3 _position;
+    glm::vec3 _previous_position;  // Position before the last fixed step
     glm::vec3 _velocity{0.0f};
     float _rotation_y = 0.0f;
 
@@ -74,6 +88,9 @@ private:
     float _attack_cooldown = 0.0f;
     float _attack_rate;  // Attacks per second
 
+    // Physics
+    engine::physics::CharacterController _controller;
+
     // Death timer
     float _death_timer = 0.0f;
     static constexpr float DEATH_DURATION = 1.0f;  // Time before removal
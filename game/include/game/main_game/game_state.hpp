@@ -8,6 +8,8 @@
 #include <game/main_game/system/wave_system.hpp>
 #include <game/main_game/map.hpp>
 #include <game/main_game/player.hpp>
+#include <engine/physics/fixed_timestep.hpp>
+#include <engine/physics/physics_world.hpp>
 
 namespace main_game {
 
@@ -19,8 +21,15 @@ public:
     ~GameState() = default;
 
     void process_input();
+
+    // Advance by one frame: gameplay runs in fixed steps, the camera and the
+    // player's animation once per frame
     void update(float delta);
 
+    // Blend factor between the previous and current fixed step, for rendering
+    float interpolation_alpha() const { return _timestep.alpha(); }
+    engine::physics::FixedTimestep& timestep() { return _timestep; }
+
     // Start the wave system
     void start_game();
 
@@ -28,6 +37,9 @@ public:
     void set_renderer(Renderer* renderer) { _renderer = renderer; }
     Renderer* renderer() const { return _renderer; }
 
+    // Declared first so it outlives the bodies owned by the members below
+    engine::physics::PhysicsWorld physics_world;
+
     GameCamera camera;
     Player player;
     Map map;
@@ -38,6 +50,9 @@ public:
     WaveSystem wave_system;
 
 private:
+    void fixed_update(float delta);
+
     Renderer* _renderer = nullptr;
+    engine::physics::FixedTimestep _timestep;
 };
 }  // namespace main_game
@@ -33,6 +33,7 @@ private:
     void despawn_far_enemies(const glm::vec3& player_pos);
 
     std::vector<Enemy> _enemies;
+    std::vector<engine::physics::CharacterController*> _controllers;  // Batched move scratch
 };
 
 }  // namespace main_game
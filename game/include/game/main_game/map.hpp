@@ -1,10 +1,41 @@
 #pragma once
 
+#include <engine/physics/height_field.hpp>
+#include <engine/physics/physics_world.hpp>
+#include <engine/physics/rigid_body.hpp>
+#include <engine/physics/triangle_mesh.hpp>
+
+#include <glm/glm.hpp>
+
+#include <string>
+
 namespace main_game {
 
+// Static level collision: the ground as a height field plus, when the level
+// model exists, its meshes as one triangle mesh. Rendering is handled by the
+// Renderer class.
 class Map {
 public:
     Map() = default;
+
+    Map(const Map&) = delete;
+    Map& operator=(const Map&) = delete;
+
+    // Build the collision geometry and add it to the world
+    void init(engine::physics::PhysicsWorld& world);
+
+    // Merge every mesh of a model into the level's triangle mesh; returns
+    // false if the model couldn't be loaded
+    bool load_collision_mesh(const std::string& filepath, engine::physics::PhysicsWorld& world);
+
+    // Ground height under a world-space point
+    float ground_height(glm::vec3 position) const;
+
+private:
+    engine::physics::HeightField _ground;
+    engine::physics::TriangleMesh _level_mesh;
+    engine::physics::RigidBody _ground_body;
+    engine::physics::RigidBody _level_body;
 };
 
 } // namespace main_game
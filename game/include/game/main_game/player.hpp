@@ -5,6 +5,7 @@
 #include <game/main_game/weapon.hpp>
 #include <game/main_game/player_animation_controller.hpp>
 #include <engine/pbr/skeleton.hpp>
+#include <engine/physics/character_controller.hpp>
 
 #include <memory>
 
@@ -19,13 +20,18 @@ public:
     void process_input(GameState&);
     void update(GameState&, float delta);
 
+    // Advance and apply the skeleton pose (once per rendered frame, with the
+    // frame delta; the pose isn't interpolated between fixed steps)
+    void update_animation(float delta);
+
     void take_damage(float amount);
     void use_stamina(float amount);
     void heal(float amount);
     void attack_main(GameState& game_state);
     void attack_sub(GameState& game_state);
 
-    glm::vec3 position() const { return _position; }
+    glm::vec3 position() const { return _controller.position(); }
+    glm::vec3 interpolated_position(float alpha) const { return glm::mix(_previous_position, position(), alpha); }
     float rotation_y() const { return _rotation_y; }
 
     // Weapons
@@ -38,6 +44,9 @@ public:
     float max_stamina() const { return _max_stamina; }
     bool is_alive() const { return _health > 0.0f; }
 
+    // Hit volume in the physics world (the character controller's capsule)
+    const engine::physics::RigidBody& body() const { return _controller.body(); }
+
     // Stat modifiers (for perks)
     float damage_multiplier() const { return _damage_multiplier; }
     float attack_speed_multiplier() const { return _attack_speed_multiplier; }
@@ -76,12 +85,15 @@ public:
 
 private:
     // Movement
-    glm::vec3 _position;
+    glm::vec3 _previous_position;  // Position before the last fixed step
     glm::vec3 _velocity;
     glm::vec3 _input_direction;
     float _rotation_y;
     float _move_speed;
 
+    // Physics
+    engine::physics::CharacterController _controller;
+
     // Skeleton (for skeletal animation)
     engine::pbr::Skeleton _skeleton;
 
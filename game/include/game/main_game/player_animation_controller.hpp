@@ -2,6 +2,7 @@
 
 #include <engine/pbr/skeleton.hpp>
 #include <engine/pbr/animation.hpp>
+#include <engine/pbr/animation_graph.hpp>
 
 #include <memory>
 
@@ -15,10 +16,12 @@ enum class PlayerAnimationType {
     RangeAttack
 };
 
-/// Controls player animation state machine and transitions
+/// Controls player animation: a locomotion layer blending idle and run by
+/// movement, with attacks played on an upper-body layer above it so the
+/// legs keep running while the player attacks
 class PlayerAnimationController {
 public:
-    PlayerAnimationController() = default;
+    PlayerAnimationController();
 
     /// Set the animation clips used by the controller
     void set_clips(
@@ -37,6 +40,9 @@ public:
     /// Apply current animation to skeleton
     void apply(engine::pbr::Skeleton& skeleton);
 
+    /// Layers evaluated by the controller (locomotion, then attacks)
+    const engine::pbr::AnimationGraph& graph() const { return _graph; }
+
     /// Trigger melee attack animation
     void trigger_melee_attack();
 
@@ -50,11 +56,18 @@ public:
     bool is_attack_playing() const { return _is_attack_playing; }
 
 private:
-    void transition_to(PlayerAnimationType new_type);
-    std::shared_ptr<engine::pbr::AnimationClip> get_clip_for_type(PlayerAnimationType type) const;
-    bool should_loop(PlayerAnimationType type) const;
+    void start_attack(PlayerAnimationType type, std::shared_ptr<engine::pbr::AnimationClip> clip);
+
+    /// Build the upper-body mask for the skeleton's hierarchy (once per hierarchy)
+    void update_attack_mask(const engine::pbr::Skeleton& skeleton);
+
+    static constexpr size_t LOCOMOTION_LAYER = 0;
+    static constexpr size_t ATTACK_LAYER = 1;
+
+    engine::pbr::AnimationGraph _graph;
+    std::shared_ptr<engine::pbr::BlendSpace1D> _locomotion;  // Idle at 0, run at 1
+    std::weak_ptr<const engine::pbr::SkeletonHierarchy> _masked_hierarchy;
 
-    engine::pbr::AnimationState _state;
     PlayerAnimationType _current_type = PlayerAnimationType::Idle;
     bool _is_attack_playing = false;
 
@@ -6,6 +6,7 @@ namespace main_game {
 
 struct Projectile {
     glm::vec3 position{0.0f};
+    glm::vec3 previous_position{0.0f};  // Position before the last fixed step
     glm::vec3 velocity{0.0f};
     float damage = 10.0f;
     float lifetime = 5.0f;
@@ -13,6 +14,7 @@ struct Projectile {
     bool is_player_projectile = true;  // true = damages enemies, false = damages player
 
     bool is_expired() const { return lifetime <= 0.0f; }
+    glm::vec3 interpolated_position(float alpha) const { return glm::mix(previous_position, position, alpha); }
 };
 
 }  // namespace main_game
@@ -93,7 +93,7 @@ private:
 
     // Helper to extract transforms from game state
     glm::mat4 get_player_transform(const GameState& game_state) const;
-    glm::mat4 get_enemy_transform(const class Enemy& enemy) const;
+    glm::mat4 get_enemy_transform(const class Enemy& enemy, float alpha) const;
 
     // Attack visual state
     float _attack_visual_timer = 0.0f;
@@ -1,5 +1,9 @@
 #pragma once
 
+namespace engine::physics {
+struct PhysicsStats;
+}
+
 namespace main_game {
 class GameState;
 class Weapon;
@@ -11,12 +15,19 @@ class GameHUD {
 public:
     void render(const GameState& state);
 
+    // Physics profiler overlay (the world only profiles while it is shown)
+    void toggle_physics_stats() { _show_physics_stats = !_show_physics_stats; }
+    bool is_showing_physics_stats() const { return _show_physics_stats; }
+
 private:
     void render_health_bar(float health, float max_health);
     void render_stamina_bar(float stamina, float max_stamina);
     void render_xp_bar(int level, float progress);
     void render_weapons_display(const Weapon& main_weapon, const Weapon& sub_weapon);
     void render_crosshair();
+    void render_physics_stats(const engine::physics::PhysicsStats& stats);
+
+    bool _show_physics_stats = false;
 };
 
 }  // namespace main_game::ui
@@ -23,6 +23,7 @@ std::unique_ptr<State> MainGame::run() {
     auto& input_system = engine::input::InputSystem::get_instance();
 
     GameState game_state;
+    game_state.map.init(game_state.physics_world);  // Level collision
     game_state.start_game();  // Start the wave system
 
     // Set up camera projection
@@ -68,6 +69,12 @@ std::unique_ptr<State> MainGame::run() {
             pause_menu.toggle();
         }
 
+        // Physics profiler overlay
+        if (input_system.is_key_just_pressed(engine::input::KeyCode::F3)) {
+            hud.toggle_physics_stats();
+            game_state.physics_world.set_profiling_enabled(hud.is_showing_physics_stats());
+        }
+
         // Toggle mouse capture based on UI state
         if (pause_menu.is_open() || perk_selection.is_open()) {
             input_system.release_mouse();
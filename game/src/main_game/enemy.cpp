@@ -1,5 +1,7 @@
+#include <game/main_game/collision_layers.hpp>
 #include <game/main_game/enemy.hpp>
 #include <game/main_game/game_state.hpp>
+#include <engine/physics/physics_world.hpp>
 
 #include <cmath>
 
@@ -38,7 +40,7 @@ static const EnemyStats RANGED_STATS = {
 
 Enemy::Enemy(EnemyType type, glm::vec3 spawn_position)
     : _type(type)
-    , _position(spawn_position)
+    , _previous_position(spawn_position)
 {
     const EnemyStats& stats = (type == EnemyType::Melee) ? MELEE_STATS : RANGED_STATS;
     _health = stats.health;
@@ -49,9 +51,38 @@ Enemy::Enemy(EnemyType type, glm::vec3 spawn_position)
     _detection_range = stats.detection_range;
     _attack_rate = stats.attack_rate;
     _collision_radius = stats.collision_radius;
+
+    // Capsule around the cube; blocked by the level, the player and other enemies
+    engine::physics::CharacterSettings settings;
+    settings.radius = _collision_radius;
+    settings.height = 1.0f;
+    settings.collision_mask = collision_layer::WORLD | collision_layer::PLAYER | collision_layer::ENEMY;
+    _controller.set_settings(settings);
+    _controller.set_position(spawn_position);
+
+    // Projectile sweeps find the capsule; it's never paired with other bodies
+    engine::physics::RigidBody& body = _controller.body();
+    body.set_collision_layer(collision_layer::ENEMY);
+    body.set_collision_mask(0);
+}
+
+void Enemy::sync_body(engine::physics::PhysicsWorld& world) {
+    // Dead enemies can't be hit any more
+    if (!is_alive()) {
+        _controller.remove_from_world();
+        return;
+    }
+
+    _controller.add_to_world(world);
+
+    // Refreshed every step since enemies move around inside their vector
+    _controller.body().user_data = this;
 }
 
 void Enemy::update(GameState& game_state, float delta) {
+    _previous_position = position();
+    _velocity = glm::vec3(0.0f);
+
     // Update attack cooldown
     if (_attack_cooldown > 0.0f) {
         _attack_cooldown -= delta;
@@ -72,6 +103,9 @@ void Enemy::update(GameState& game_state, float delta) {
             update_dead(game_state, delta);
             break;
     }
+
+    // Applied by the EnemyManager's batched move
+    _controller.set_desired_velocity(_velocity);
 }
 
 void Enemy::update_idle(GameState& game_state, float delta) {
@@ -108,14 +142,13 @@ void Enemy::update_chasing(GameState& game_state, float delta) {
         if (dist < preferred_distance) {
             glm::vec3 away = -direction_to_player(game_state);
             _velocity = away * _move_speed;
-            _position += _velocity * delta;
             face_player(game_state);
             return;
         }
     }
 
     // Move toward player
-    move_toward_player(game_state, delta);
+    move_toward_player(game_state);
 }
 
 void Enemy::update_attacking(GameState& game_state, float delta) {
@@ -169,17 +202,17 @@ void Enemy::take_damage(float amount, GameState& game_state, glm::vec3 impact_po
         game_state.progression_system.on_enemy_killed(_type);
 
         // Spawn explosion particles at enemy center
-        glm::vec3 center = _position + glm::vec3(0.0f, 0.5f, 0.0f);
+        glm::vec3 center = position() + glm::vec3(0.0f, 0.5f, 0.0f);
         game_state.particle_system.spawn_explosion(center, 25);
     }
 }
 
 float Enemy::distance_to_player(const GameState& game_state) const {
-    return glm::length(game_state.player.position() - _position);
+    return glm::length(game_state.player.position() - position());
 }
 
 glm::vec3 Enemy::direction_to_player(const GameState& game_state) const {
-    glm::vec3 diff = game_state.player.position() - _position;
+    glm::vec3 diff = game_state.player.position() - position();
     if (glm::length(diff) > 0.001f) {
         return glm::normalize(diff);
     }
@@ -191,10 +224,9 @@ void Enemy::face_player(const GameState& game_state) {
     _rotation_y = atan2(dir.x, dir.z);
 }
 
-void Enemy::move_toward_player(const GameState& game_state, float delta) {
+void Enemy::move_toward_player(const GameState& game_state) {
     glm::vec3 dir = direction_to_player(game_state);
     _velocity = dir * _move_speed;
-    _position += _velocity * delta;
     _rotation_y = atan2(dir.x, dir.z);
 }
 
@@ -205,7 +237,7 @@ void Enemy::attack_melee(GameState& game_state) {
 
 void Enemy::attack_ranged(GameState& game_state) {
     // Spawn projectile via ProjectileManager
-    glm::vec3 spawn_pos = _position + glm::vec3(0.0f, 1.0f, 0.0f);
+    glm::vec3 spawn_pos = position() + glm::vec3(0.0f, 1.0f, 0.0f);
     glm::vec3 direction = direction_to_player(game_state);
     game_state.projectile_manager.spawn_projectile(spawn_pos, direction, _damage, false);
 }
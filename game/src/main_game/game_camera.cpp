@@ -55,7 +55,7 @@ void GameCamera::update(GameState& state, float delta) {
     }
 
     // Base target is player position + height offset
-    glm::vec3 base_target = state.player.position() + glm::vec3(0.0f, 1.0f, 0.0f);
+    glm::vec3 base_target = state.player.interpolated_position(state.interpolation_alpha()) + glm::vec3(0.0f, 1.0f, 0.0f);
 
     // Always use over-the-shoulder offset (Warframe style)
     glm::vec3 right = _camera.right_xz();
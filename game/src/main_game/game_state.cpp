@@ -10,6 +10,19 @@ void GameState::process_input() {
 }
 
 void GameState::update(float delta) {
+    int steps = _timestep.advance(delta);
+    for (int i = 0; i < steps; ++i) {
+        fixed_update(_timestep.step());
+    }
+
+    // Skeleton pose once per frame, after the steps moved the player
+    player.update_animation(delta);
+
+    // Update camera last to target it on updated player
+    camera.update(*this, delta);
+}
+
+void GameState::fixed_update(float delta) {
     player.update(*this, delta);
 
     // Update wave system (handles enemy spawning)
@@ -18,14 +31,14 @@ void GameState::update(float delta) {
     // Update enemies
     enemy_manager.update(*this, delta);
 
+    // Step physics so queries see this step's player and enemy positions
+    physics_world.update(delta);
+
     // Update projectiles
     projectile_manager.update(*this, delta);
 
     // Update particles
     particle_system.update(delta);
-
-    // Update camera last to target it on updated player
-    camera.update(*this, delta);
 }
 
 void GameState::start_game() {
@@ -1,5 +1,6 @@
 #include <game/main_game/manager/enemy_manager.hpp>
 #include <game/main_game/game_state.hpp>
+#include <engine/physics/physics_world.hpp>
 
 #include <algorithm>
 #include <cmath>
@@ -17,6 +18,17 @@ void EnemyManager::update(GameState& game_state, float delta) {
 
     // Remove dead enemies that have finished their death animation
     remove_dead_enemies();
+
+    // Move every living enemy in one batched controller call
+    _controllers.clear();
+    for (auto& enemy : _enemies) {
+        enemy.sync_body(game_state.physics_world);
+        if (enemy.is_alive()) {
+            _controllers.push_back(&enemy.controller());
+        }
+    }
+    engine::physics::CharacterController::move_all(game_state.physics_world, _controllers.data(),
+                                                   _controllers.size(), delta);
 }
 
 void EnemyManager::spawn_enemy(EnemyType type, glm::vec3 position) {
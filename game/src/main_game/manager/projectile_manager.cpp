@@ -1,5 +1,7 @@
 #include <game/main_game/manager/projectile_manager.hpp>
+#include <game/main_game/collision_layers.hpp>
 #include <game/main_game/game_state.hpp>
+#include <engine/physics/physics_world.hpp>
 
 #include <algorithm>
 
@@ -16,6 +18,7 @@ void ProjectileManager::spawn_projectile(glm::vec3 position, glm::vec3 direction
                                          float speed) {
     Projectile proj;
     proj.position = position;
+    proj.previous_position = position;
     proj.velocity = glm::normalize(direction) * speed;
     proj.damage = damage;
     proj.is_player_projectile = is_player_projectile;
@@ -30,45 +33,59 @@ void ProjectileManager::clear_all() {
 
 void ProjectileManager::move_projectiles(float delta) {
     for (auto& proj : _projectiles) {
+        proj.previous_position = proj.position;
         proj.position += proj.velocity * delta;
         proj.lifetime -= delta;
     }
 }
 
 void ProjectileManager::check_collisions(GameState& game_state) {
-    const float player_collision_radius = 0.5f;
+    using engine::physics::RigidBody;
+
+    // Player projectiles hit living enemies, enemy projectiles hit the living
+    // player, and both stop at level geometry (layer masks pick the side, the
+    // filters skip anyone killed by an earlier projectile this step)
+    auto is_world = [](const RigidBody* body) {
+        return (body->collision_layer() & collision_layer::WORLD) != 0;
+    };
+    auto hits_enemies = [&](const RigidBody* body) {
+        return is_world(body) || static_cast<const Enemy*>(body->user_data)->is_alive();
+    };
+    auto hits_player = [&](const RigidBody* body) {
+        return is_world(body) || game_state.player.is_alive();
+    };
 
     for (auto& proj : _projectiles) {
         if (proj.is_expired()) continue;
 
-        if (proj.is_player_projectile) {
-            // Check collision with enemies
-            for (auto& enemy : game_state.enemy_manager.enemies()) {
-                if (!enemy.is_alive()) continue;
-
-                // Enemy center is at Y=0.5 (cube sits on ground)
-                glm::vec3 enemy_center = enemy.position() + glm::vec3(0.0f, 0.5f, 0.0f);
-                float dist = glm::length(enemy_center - proj.position);
-                if (dist < proj.radius + enemy.collision_radius()) {
-                    enemy.take_damage(proj.damage, game_state, proj.position);
-                    // Apply lifesteal if player has it
-                    game_state.player.on_damage_dealt(proj.damage);
-                    proj.lifetime = 0.0f;  // Mark for removal
-                    break;
-                }
-            }
+        // Sweep the whole path of this step so fast projectiles can't pass
+        // through a target (or a wall) between two positions
+        glm::vec3 motion = proj.position - proj.previous_position;
+        engine::physics::SweepHit hit;
+        bool found = proj.is_player_projectile
+            ? game_state.physics_world.sweep_sphere(proj.previous_position, proj.radius, motion, hit,
+                                                    collision_layer::ENEMY | collision_layer::WORLD,
+                                                    hits_enemies)
+            : game_state.physics_world.sweep_sphere(proj.previous_position, proj.radius, motion, hit,
+                                                    collision_layer::PLAYER | collision_layer::WORLD,
+                                                    hits_player);
+        if (!found) continue;
+
+        glm::vec3 impact_pos = proj.previous_position + motion * hit.time;
+
+        if (is_world(hit.body)) {
+            // Stopped by the level: no damage
+        } else if (proj.is_player_projectile) {
+            auto* enemy = static_cast<Enemy*>(hit.body->user_data);
+            enemy->take_damage(proj.damage, game_state, impact_pos);
+            // Apply lifesteal if player has it
+            game_state.player.on_damage_dealt(proj.damage);
         } else {
-            // Check collision with player
-            if (!game_state.player.is_alive()) continue;
-
-            // Player center is at Y=1.0 (approximate torso height)
-            glm::vec3 player_center = game_state.player.position() + glm::vec3(0.0f, 1.0f, 0.0f);
-            float dist = glm::length(player_center - proj.position);
-            if (dist < proj.radius + player_collision_radius) {
-                game_state.player.take_damage(proj.damage);
-                proj.lifetime = 0.0f;
-            }
+            game_state.player.take_damage(proj.damage);
         }
+
+        proj.position = impact_pos;
+        proj.lifetime = 0.0f;  // Mark for removal
     }
 }
 
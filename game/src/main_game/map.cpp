@@ -1,8 +1,66 @@
 #include <game/main_game/map.hpp>
+#include <game/main_game/collision_layers.hpp>
+#include <engine/resource/loaders/model_loader.hpp>
+
+#include <filesystem>
+#include <utility>
+#include <vector>
 
 namespace main_game {
 
-// Map is currently just a placeholder for future map data
-// Rendering is handled by the Renderer class
+namespace {
+
+constexpr float GROUND_SIZE = 400.0f;       // Enemies despawn well inside this
+constexpr float GROUND_CELL_SIZE = 4.0f;
+constexpr const char* LEVEL_COLLISION_MODEL = "level_collision.glb";
+
+}  // namespace
+
+void Map::init(engine::physics::PhysicsWorld& world) {
+    // Flat ground at y = 0, centered on the origin
+    uint32_t samples = static_cast<uint32_t>(GROUND_SIZE / GROUND_CELL_SIZE) + 1;
+    _ground = engine::physics::HeightField(samples, samples, GROUND_CELL_SIZE,
+                                           std::vector<float>(samples * samples, 0.0f));
+
+    _ground_body.set_height_field(&_ground);
+    _ground_body.set_position(glm::vec3(-GROUND_SIZE * 0.5f, 0.0f, -GROUND_SIZE * 0.5f));
+    _ground_body.set_collision_layer(collision_layer::WORLD);
+    world.add_body(&_ground_body);
+
+    // Level geometry is optional, like the player model
+    if (std::filesystem::exists(LEVEL_COLLISION_MODEL)) {
+        load_collision_mesh(LEVEL_COLLISION_MODEL, world);
+    }
+}
+
+bool Map::load_collision_mesh(const std::string& filepath, engine::physics::PhysicsWorld& world) {
+    auto meshes = engine::resource::ModelLoader::load_mesh_data(filepath);
+    if (meshes.empty()) return false;
+
+    std::vector<glm::vec3> vertices;
+    std::vector<uint32_t> indices;
+    for (const auto& mesh : meshes) {
+        uint32_t base = static_cast<uint32_t>(vertices.size());
+        vertices.insert(vertices.end(), mesh.positions.begin(), mesh.positions.end());
+        for (unsigned int index : mesh.indices) {
+            indices.push_back(base + index);
+        }
+    }
+
+    if (_level_body.world()) {
+        world.remove_body(&_level_body);
+    }
+    _level_mesh = engine::physics::TriangleMesh(std::move(vertices), std::move(indices));
+
+    _level_body.set_mesh(&_level_mesh);
+    _level_body.set_collision_layer(collision_layer::WORLD);
+    world.add_body(&_level_body);
+    return true;
+}
+
+float Map::ground_height(glm::vec3 position) const {
+    glm::vec3 local = position - _ground_body.position();
+    return _ground.height_at(local.x, local.z);
+}
 
 } // namespace main_game
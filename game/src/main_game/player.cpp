@@ -1,22 +1,37 @@
+#include <game/main_game/collision_layers.hpp>
 #include <game/main_game/game_state.hpp>
 #include <game/main_game/player.hpp>
 #include <engine/input/input_system.hpp>
 #include <engine/input/key_codes.hpp>
+#include <engine/physics/physics_world.hpp>
 
 #include <cmath>
 
 namespace main_game {
 
 Player::Player()
-    : _position(0.0f, 0.0f, 0.0f)
+    : _previous_position(0.0f, 0.0f, 0.0f)
     , _velocity(0.0f)
     , _input_direction(0.0f)
     , _rotation_y(0.0f)
     , _move_speed(5.0f)
     , _main_weapon(std::make_unique<Sword>())
-    , _sub_weapon(std::make_unique<Gun>()) {}
+    , _sub_weapon(std::make_unique<Gun>()) {
+    // Blocked by the level and by enemies
+    engine::physics::CharacterSettings settings;
+    settings.collision_mask = collision_layer::WORLD | collision_layer::ENEMY;
+    _controller.set_settings(settings);
+
+    // Projectile sweeps find the capsule; it's never paired with other bodies
+    engine::physics::RigidBody& body = _controller.body();
+    body.set_collision_layer(collision_layer::PLAYER);
+    body.set_collision_mask(0);
+    body.user_data = this;
+}
 
 void Player::update(GameState& game_state, float delta) {
+    _previous_position = position();
+
     // Update attack cooldowns
     if (_main_attack_cooldown > 0.0f) {
         _main_attack_cooldown -= delta;
@@ -35,7 +50,7 @@ void Player::update(GameState& game_state, float delta) {
     if (glm::length(_input_direction) > 0.0f) {
         glm::vec3 direction = glm::normalize(_input_direction);
         float effective_speed = _move_speed * _move_speed_multiplier;
-        _velocity = direction * effective_speed * delta;
+        _velocity = direction * effective_speed;
 
         // Rotate player to face movement direction
         _rotation_y = atan2(direction.x, direction.z);
@@ -43,16 +58,20 @@ void Player::update(GameState& game_state, float delta) {
         _velocity = glm::vec3(0.0f);
     }
 
-    // Apply velocity to position
-    _position += _velocity;
+    // Collide and slide against the level and the enemies
+    _controller.add_to_world(game_state.physics_world);
+    _controller.set_desired_velocity(_velocity);
+    _controller.move(game_state.physics_world, delta);
 
-    // Update animation - use input direction instead of velocity to avoid delta-dependent flickering
+    // Input direction is kept for every fixed step of the frame; process_input
+    // overwrites it next frame
+}
+
+void Player::update_animation(float delta) {
+    // Use input direction instead of velocity to avoid delta-dependent flickering
     bool is_moving = glm::length(_input_direction) > 0.01f;
     _animation_controller.update(delta, is_moving, _main_attack_cooldown > 0.0f, _sub_attack_cooldown > 0.0f);
     _animation_controller.apply(_skeleton);
-
-    // Reset input direction for next frame (after animation uses it)
-    _input_direction = glm::vec3(0.0f);
 }
 
 void Player::process_input(GameState& state) {
@@ -116,8 +135,8 @@ void Player::attack_main(GameState& game_state) {
     // Apply attack speed multiplier to cooldown
     _main_attack_cooldown = _main_weapon->cooldown() / _attack_speed_multiplier;
 
-    glm::vec3 facing = game_state.camera.get_aim_direction(_position);
-    _main_weapon->attack(game_state, _position, facing);
+    glm::vec3 facing = game_state.camera.get_aim_direction(position());
+    _main_weapon->attack(game_state, position(), facing);
 
     _animation_controller.trigger_melee_attack();
 }
@@ -128,8 +147,8 @@ void Player::attack_sub(GameState& game_state) {
     // Apply attack speed multiplier to cooldown
     _sub_attack_cooldown = _sub_weapon->cooldown() / _attack_speed_multiplier;
 
-    glm::vec3 facing = game_state.camera.get_aim_direction(_position);
-    _sub_weapon->attack(game_state, _position, facing);
+    glm::vec3 facing = game_state.camera.get_aim_direction(position());
+    _sub_weapon->attack(game_state, position(), facing);
 
     _animation_controller.trigger_range_attack();
 }
@@ -1,7 +1,30 @@
 #include <game/main_game/player_animation_controller.hpp>
 
+#include <algorithm>
+
 namespace main_game {
 
+namespace {
+
+// Time to blend between idle and run, and to fade the attack layer in/out
+constexpr float LOCOMOTION_BLEND_TIME = 0.15f;
+constexpr float ATTACK_FADE_IN = 0.1f;
+constexpr float ATTACK_FADE_OUT = 0.15f;
+
+// Names the upper-body root goes by in common rigs; attacks fall back to the
+// whole body if the skeleton has none of them
+constexpr const char* UPPER_BODY_ROOTS[] = {"Spine", "Spine1", "spine", "spine_01", "mixamorig:Spine"};
+
+}  // namespace
+
+PlayerAnimationController::PlayerAnimationController()
+    : _locomotion(std::make_shared<engine::pbr::BlendSpace1D>())
+{
+    // Layer 0: locomotion blend space, layer 1: attacks (faded in when used)
+    _graph.add_layer().set_blend_space(_locomotion);
+    _graph.add_layer().set_weight(0.0f);
+}
+
 void PlayerAnimationController::set_clips(
     std::shared_ptr<engine::pbr::AnimationClip> idle,
     std::shared_ptr<engine::pbr::AnimationClip> run,
@@ -13,12 +36,11 @@ void PlayerAnimationController::set_clips(
     _melee_attack = melee_attack;
     _range_attack = range_attack;
 
-    // Start with idle animation
-    if (_idle) {
-        _state.set_clip(_idle);
-        _state.set_looping(true);
-        _state.play();
-    }
+    // Locomotion starts idle; update() moves the parameter toward run
+    _locomotion = std::make_shared<engine::pbr::BlendSpace1D>();
+    _locomotion->add_clip(_idle, 0.0f);
+    _locomotion->add_clip(_run, 1.0f);
+    _graph.layer(LOCOMOTION_LAYER).set_blend_space(_locomotion);
 }
 
 void PlayerAnimationController::update(
@@ -38,64 +60,66 @@ void PlayerAnimationController::update(
 
         if (attack_finished) {
             _is_attack_playing = false;
-            transition_to(is_moving ? PlayerAnimationType::Running : PlayerAnimationType::Idle);
-        }
-    } else {
-        // Update based on movement when not attacking
-        if (is_moving && _current_type != PlayerAnimationType::Running) {
-            transition_to(PlayerAnimationType::Running);
-        } else if (!is_moving && _current_type != PlayerAnimationType::Idle) {
-            transition_to(PlayerAnimationType::Idle);
+            _graph.layer(ATTACK_LAYER).fade_to(0.0f, ATTACK_FADE_OUT);
         }
     }
 
+    if (!_is_attack_playing) {
+        _current_type = is_moving ? PlayerAnimationType::Running : PlayerAnimationType::Idle;
+    }
+
+    // Locomotion keeps running under attacks: move the blend toward run or idle
+    float target = is_moving ? 1.0f : 0.0f;
+    float step = delta / LOCOMOTION_BLEND_TIME;
+    float parameter = _locomotion->parameter();
+    _locomotion->set_parameter(target > parameter ? std::min(parameter + step, target)
+                                                  : std::max(parameter - step, target));
+
     // Update animation time
-    _state.update(delta);
+    _graph.update(delta);
 }
 
 void PlayerAnimationController::apply(engine::pbr::Skeleton& skeleton) {
-    if (_state.clip()) {
-        _state.apply(skeleton);
-    }
+    update_attack_mask(skeleton);
+    _graph.apply(skeleton);
 }
 
 void PlayerAnimationController::trigger_melee_attack() {
-    _is_attack_playing = true;
-    transition_to(PlayerAnimationType::MeleeAttack);
+    start_attack(PlayerAnimationType::MeleeAttack, _melee_attack);
 }
 
 void PlayerAnimationController::trigger_range_attack() {
-    _is_attack_playing = true;
-    transition_to(PlayerAnimationType::RangeAttack);
+    start_attack(PlayerAnimationType::RangeAttack, _range_attack);
 }
 
-void PlayerAnimationController::transition_to(PlayerAnimationType new_type) {
-    if (_current_type == new_type) return;
-
-    _current_type = new_type;
-    auto clip = get_clip_for_type(new_type);
+void PlayerAnimationController::start_attack(
+    PlayerAnimationType type,
+    std::shared_ptr<engine::pbr::AnimationClip> clip)
+{
+    _is_attack_playing = true;
+    _current_type = type;
+    if (!clip) return;
 
-    if (clip) {
-        // Use crossfade for smoother transitions
-        constexpr float BLEND_DURATION = 0.15f;
-        _state.crossfade_to(clip, BLEND_DURATION, should_loop(new_type));
-    }
+    // Restart the attack from its first frame, crossfading from a previous one
+    auto& layer = _graph.layer(ATTACK_LAYER);
+    float fade = layer.weight() > 0.0f ? ATTACK_FADE_IN : 0.0f;
+    layer.play(clip, fade, false);
+    layer.fade_to(1.0f, ATTACK_FADE_IN);
 }
 
-std::shared_ptr<engine::pbr::AnimationClip> PlayerAnimationController::get_clip_for_type(
-    PlayerAnimationType type) const
-{
-    switch (type) {
-        case PlayerAnimationType::Idle:       return _idle;
-        case PlayerAnimationType::Running:    return _run;
-        case PlayerAnimationType::MeleeAttack: return _melee_attack;
-        case PlayerAnimationType::RangeAttack: return _range_attack;
-    }
-    return nullptr;
-}
+void PlayerAnimationController::update_attack_mask(const engine::pbr::Skeleton& skeleton) {
+    if (!skeleton.hierarchy || _masked_hierarchy.lock() == skeleton.hierarchy) return;
+    _masked_hierarchy = skeleton.hierarchy;
 
-bool PlayerAnimationController::should_loop(PlayerAnimationType type) const {
-    return type == PlayerAnimationType::Idle || type == PlayerAnimationType::Running;
+    std::shared_ptr<const engine::pbr::BoneMask> mask;
+    for (const char* name : UPPER_BODY_ROOTS) {
+        if (skeleton.hierarchy->find_node(name) >= 0) {
+            mask = std::make_shared<engine::pbr::BoneMask>(
+                engine::pbr::BoneMask::subtree(*skeleton.hierarchy, name));
+            break;
+        }
+    }
+    _graph.layer(ATTACK_LAYER).set_mask(mask);
 }
 
 }  // namespace main_game
@@ -252,6 +252,7 @@ void Renderer::render(const GameState& game_state, std::function<void()> ui_call
             player_skeleton.bindpose = model_skeleton->bindpose;
             player_skeleton.bone_index_map = model_skeleton->bone_index_map;
             player_skeleton.root_node = model_skeleton->root_node;
+            player_skeleton.hierarchy = model_skeleton->hierarchy;
             
             // Initialize transforms for T-pose (bind pose)
             // For the mesh to render in its original pose, bone transforms should be identity
@@ -276,8 +277,11 @@ void Renderer::render(const GameState& game_state, std::function<void()> ui_call
         skeleton_initialized = true;
     }
 
+    // Gameplay runs in fixed steps; draw everything blended between the last two
+    float alpha = game_state.interpolation_alpha();
+
     // Submit ground (follows player position for infinite ground effect)
-    glm::vec3 player_pos = game_state.player.position();
+    glm::vec3 player_pos = game_state.player.interpolated_position(alpha);
     glm::mat4 ground_transform = glm::translate(glm::mat4(1.0f), glm::vec3(player_pos.x, 0.0f, player_pos.z));
     _pbr_context.submit(*_ground_mesh, *_ground_material, ground_transform);
     
@@ -294,13 +298,13 @@ void Renderer::render(const GameState& game_state, std::function<void()> ui_call
             auto& material = (enemy.type() == EnemyType::Melee)
                 ? *_melee_enemy_material
                 : *_ranged_enemy_material;
-            _pbr_context.submit(*_enemy_mesh, material, get_enemy_transform(enemy));
+            _pbr_context.submit(*_enemy_mesh, material, get_enemy_transform(enemy, alpha));
         }
     }
 
     // Submit projectiles (cuboid oriented along velocity)
     for (const auto& proj : game_state.projectile_manager.projectiles()) {
-        glm::mat4 proj_transform = glm::translate(glm::mat4(1.0f), proj.position);
+        glm::mat4 proj_transform = glm::translate(glm::mat4(1.0f), proj.interpolated_position(alpha));
 
         // Orient cuboid along velocity direction
         glm::vec3 vel_dir = glm::normalize(proj.velocity);
@@ -349,15 +353,15 @@ void Renderer::render(const GameState& game_state, std::function<void()> ui_call
 glm::mat4 Renderer::get_player_transform(const GameState& game_state) const {
     const Player& player = game_state.player;
     glm::mat4 transform = glm::mat4(1.0f);
-    transform = glm::translate(transform, player.position());
+    transform = glm::translate(transform, player.interpolated_position(game_state.interpolation_alpha()));
     transform = glm::rotate(transform, player.rotation_y(), glm::vec3(0.0f, 1.0f, 0.0f));
     return transform;
 }
 
-glm::mat4 Renderer::get_enemy_transform(const Enemy& enemy) const {
+glm::mat4 Renderer::get_enemy_transform(const Enemy& enemy, float alpha) const {
     glm::mat4 transform = glm::mat4(1.0f);
     // Offset Y by 0.5 so cube sits on ground (cube is 1.0 unit, centered at origin)
-    glm::vec3 pos = enemy.position() + glm::vec3(0.0f, 0.5f, 0.0f);
+    glm::vec3 pos = enemy.interpolated_position(alpha) + glm::vec3(0.0f, 0.5f, 0.0f);
     transform = glm::translate(transform, pos);
     transform = glm::rotate(transform, enemy.rotation_y(), glm::vec3(0.0f, 1.0f, 0.0f));
     return transform;
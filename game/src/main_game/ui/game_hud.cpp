@@ -4,6 +4,7 @@
 #include <game/main_game/weapon.hpp>
 #include <engine/window/window_system.hpp>
 #include <engine/ui/ui_system.hpp>
+#include <engine/physics/physics_stats.hpp>
 
 namespace main_game::ui {
 
@@ -16,6 +17,10 @@ void GameHUD::render(const GameState& state) {
     render_xp_bar(progression.level(), progression.xp_progress());
     render_weapons_display(player.main_weapon(), player.sub_weapon());
     render_crosshair();
+
+    if (_show_physics_stats) {
+        render_physics_stats(state.physics_world.stats());
+    }
 }
 
 void GameHUD::render_health_bar(float health, float max_health) {
@@ -175,4 +180,47 @@ void GameHUD::render_crosshair() {
     draw_list->AddCircleFilled(ImVec2(center_x, center_y), 2.0f, color);
 }
 
+void GameHUD::render_physics_stats(const engine::physics::PhysicsStats& stats) {
+    using engine::physics::PhysicsPhase;
+
+    ImGuiWindowFlags flags = ImGuiWindowFlags_NoTitleBar |
+                             ImGuiWindowFlags_NoResize |
+                             ImGuiWindowFlags_NoMove |
+                             ImGuiWindowFlags_NoScrollbar |
+                             ImGuiWindowFlags_NoCollapse |
+                             ImGuiWindowFlags_NoSavedSettings;
+
+    float screen_width = static_cast<float>(engine::window::SCR_WIDTH);
+
+    ImGui::SetNextWindowPos(ImVec2(screen_width - 260, 20));
+    ImGui::SetNextWindowSize(ImVec2(240, 250));
+
+    ImGui::Begin("PhysicsStats", nullptr, flags);
+
+    ImGui::TextColored(ImVec4(0.9f, 0.8f, 0.4f, 1.0f), "Physics (F3)");
+
+    // Times per step, so frames running several fixed steps stay comparable
+    double per_step = stats.steps > 0 ? 1.0 / stats.steps : 0.0;
+    const PhysicsPhase phases[] = {
+        PhysicsPhase::Integrate, PhysicsPhase::BroadPhase, PhysicsPhase::NarrowPhase,
+        PhysicsPhase::Solve, PhysicsPhase::QueryTree, PhysicsPhase::Sleep,
+    };
+    for (PhysicsPhase phase : phases) {
+        ImGui::Text("%-13s %6.3f ms", engine::physics::phase_name(phase), stats.time(phase) * per_step);
+    }
+    ImGui::Text("%-13s %6.3f ms", "total", stats.total_ms * per_step);
+
+    ImGui::Separator();
+    ImGui::Text("pairs   %llu -> %llu (%.0f%%)",
+                static_cast<unsigned long long>(stats.candidate_pairs),
+                static_cast<unsigned long long>(stats.touching_pairs), stats.hit_ratio() * 100.0);
+    ImGui::Text("contacts %llu in %llu islands",
+                static_cast<unsigned long long>(stats.contacts),
+                static_cast<unsigned long long>(stats.islands));
+    ImGui::Text("bodies  %u (%u static, %u asleep)",
+                stats.body_count, stats.static_body_count, stats.sleeping_body_count);
+
+    ImGui::End();
+}
+
 }  // namespace main_game::ui